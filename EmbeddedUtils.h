@@ -23,6 +23,14 @@
 #include "lib/Filters.h"
 #include "lib/MatrixFunc.h"
 #include "lib/RingQueue.h"
+#include "lib/SpscRingQueue.h"
+#include "lib/MpmcRingQueue.h"
+#include "lib/BroadcastRing.h"
+#include "lib/TripleBuffer.h"
+#include "lib/RecordRing.h"
+#include "lib/DynamicRingQueue.h"
+#include "lib/SlidingWindow.h"
+#include "lib/TimedRingQueue.h"
 #include "lib/Vec.h"
 #include "lib/Gamma.h"
 #include "lib/I2CHelper.h"
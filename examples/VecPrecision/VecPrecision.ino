@@ -0,0 +1,89 @@
+// compares the two EMBEDDEDUTILS_VEC_PRECISION policies of the normalizing Vec methods on this board:
+// - time of normalizing N vectors: sqrt + 3 divides (EXACT) vs VecPrecision::rsqrt + 3 multiplies (FAST)
+// - maximum relative error of VecPrecision::rsqrt against 1 / sqrt over the normal float range
+// both paths are written out here so one build measures both, whatever EMBEDDEDUTILS_VEC_PRECISION is
+
+#include <EmbeddedUtils.h>
+
+const size_t N = 256;
+const int REPEAT = 20;
+
+float vx[N], vy[N], vz[N];
+volatile float sink;
+
+uint32_t time_exact()
+{
+    const uint32_t begin = micros();
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            const float l = sqrtf(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+            sink = vx[i] / l + vy[i] / l + vz[i] / l;
+        }
+    }
+    return micros() - begin;
+}
+
+uint32_t time_fast()
+{
+    const uint32_t begin = micros();
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            const float inv = VecPrecision::rsqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+            sink = vx[i] * inv + vy[i] * inv + vz[i] * inv;
+        }
+    }
+    return micros() - begin;
+}
+
+double max_rsqrt_error()
+{
+    // mantissas across [1, 4) (both exponent parities of the seed) at exponents across the normal range
+    double max_error = 0.0;
+    for (uint32_t m = 0; m < 0x1000000ul; m += 61)
+    {
+        uint32_t bits = 0x3f800000u + m;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        for (float scale = 1.0e-36f; scale < 1.0e36f; scale *= 1.0e6f)
+        {
+            const float x = f * scale;
+            const double exact = 1.0 / sqrt((double)x);
+            const double error = fabs(VecPrecision::rsqrt(x) - exact) / exact;
+            if (error > max_error) max_error = error;
+        }
+    }
+    return max_error;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    delay(2000);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        vx[i] = (float)random(-10000, 10000) * 0.01f;
+        vy[i] = (float)random(-10000, 10000) * 0.01f;
+        vz[i] = (float)random(1, 10000) * 0.01f;
+    }
+
+    const uint32_t exact = time_exact();
+    const uint32_t fast = time_fast();
+    Serial.print("normalize x ");
+    Serial.println(N * REPEAT);
+    Serial.print("  EXACT [us] : ");
+    Serial.println(exact);
+    Serial.print("  FAST  [us] : ");
+    Serial.println(fast);
+
+    Serial.print("rsqrt max relative error : ");
+    Serial.println(max_rsqrt_error(), 9);
+}
+
+void loop()
+{
+}
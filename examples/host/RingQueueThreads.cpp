@@ -0,0 +1,279 @@
+// threaded check and throughput of SpscRingQueue, MpmcRingQueue and BlockingRingQueue on a host
+// - every element carries its sequence number and a payload derived from it in plain (non-atomic) fields,
+//   so a consumer seeing a payload that does not match its sequence means an element was published
+//   before it was written: the acquire / release pairs of the queues are what this checks
+// - SpscRingQueue runs with producer and consumer pinned to two cores (Linux), next to the layout it had
+//   before its indices were padded to cache lines, so the cost of the shared line shows up as the ratio
+// - MpmcRingQueue runs k producers against k consumers for k = 1 .. N, N from the command line
+//   or std::thread::hardware_concurrency()
+// - build and run from the repository root, optionally with -fsanitize=thread
+//   (ThreadSanitizer warns that it does not model the fences in BlockingRingQueue):
+//     g++ -std=c++11 -O2 -pthread -I. examples/host/RingQueueThreads.cpp -o ring_queue_threads
+//     ./ring_queue_threads [N]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "lib/SpscRingQueue.h"
+#include "lib/MpmcRingQueue.h"
+#include "lib/BlockingRingQueue.h"
+#include "lib/detail/RingIndex.h"
+
+static const uint32_t COUNT = 1000000;
+static const int REPEAT = 3;
+
+struct Element
+{
+    uint32_t producer;
+    uint32_t seq;
+    uint64_t payload;
+};
+
+static inline uint64_t payload(const uint32_t producer, const uint32_t seq)
+{
+    return ((uint64_t)producer << 32 | seq) * 0x9e3779b97f4a7c15ull;
+}
+
+static inline bool valid(const Element& e)
+{
+    return e.payload == payload(e.producer, e.seq);
+}
+
+static inline double mops(const uint64_t count, const std::chrono::steady_clock::time_point begin)
+{
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return count / sec * 1e-6;
+}
+
+static void report(const char* name, const uint64_t count, const std::chrono::steady_clock::time_point begin, const bool ok)
+{
+    printf("%-32s %s  %8.1f Mops/s\n", name, ok ? "ok  " : "FAIL", mops(count, begin));
+}
+
+// keeps the calling thread on one core, so that the two sides of a queue stay on different cores
+static void pin(const unsigned core)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % std::thread::hardware_concurrency(), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+// the SpscRingQueue layout before the cache-line padding, as the baseline of spsc():
+// head_, tail_ and the first slots share a cache line, and every push() / pop() reloads the other side's index
+template<typename T, size_t QUEUE_SIZE>
+class UnpaddedSpscRingQueue
+{
+    using Index = RingIndex::Fixed<QUEUE_SIZE, uint32_t>;
+
+public:
+    inline bool empty() const
+    {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    };
+
+    inline bool push(const T& data)
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (Index::distance(tail, head_.load(std::memory_order_acquire)) == QUEUE_SIZE) return false;
+        queue_[Index::slot(tail)] = data;
+        tail_.store(Index::next(tail), std::memory_order_release);
+        return true;
+    };
+    inline bool pop(T& data)
+    {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        data = queue_[Index::slot(head)];
+        head_.store(Index::next(head), std::memory_order_release);
+        return true;
+    };
+
+private:
+    std::atomic<uint32_t> head_ {0};
+    std::atomic<uint32_t> tail_ {0};
+    T queue_[QUEUE_SIZE];
+};
+
+// one producer on core 0, one consumer on core 1: every element arrives once, in order;
+// both sides poll, yielding only now and then so that an oversubscribed host still makes progress
+template <typename Queue>
+static double spsc_run(Queue& queue, bool& ok)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    std::thread producer([&queue]
+    {
+        pin(0);
+        uint32_t misses = 0;
+        for (uint32_t i = 0; i < COUNT; )
+        {
+            if (queue.push(Element { 0, i, payload(0, i) })) ++i;
+            else if (++misses % 64 == 0) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&queue, &ok]
+    {
+        pin(1);
+        uint32_t misses = 0;
+        Element e;
+        for (uint32_t i = 0; i < COUNT; )
+        {
+            if (!queue.pop(e))
+            {
+                if (++misses % 64 == 0) std::this_thread::yield();
+                continue;
+            }
+            if (e.seq != i || !valid(e)) ok = false;
+            ++i;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    const double result = mops(COUNT, begin);
+    ok = ok && queue.empty();
+    return result;
+}
+
+// best of REPEAT runs of the padded queue and of the unpadded baseline
+static bool spsc()
+{
+    static SpscRingQueue<Element, 1024> padded;
+    static UnpaddedSpscRingQueue<Element, 1024> unpadded;
+    bool ok = true;
+    double best_padded = 0.0, best_unpadded = 0.0;
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        const double p = spsc_run(padded, ok);
+        const double u = spsc_run(unpadded, ok);
+        if (p > best_padded) best_padded = p;
+        if (u > best_unpadded) best_unpadded = u;
+    }
+
+    printf("%-32s %s  %8.1f Mops/s padded, %8.1f Mops/s unpadded (x%.2f)%s\n", "SpscRingQueue 1:1", ok ? "ok  " : "FAIL",
+           best_padded, best_unpadded, best_padded / best_unpadded,
+           (std::thread::hardware_concurrency() < 2) ? ", single core: not cross-core" : "");
+    return ok;
+}
+
+// k producers : k consumers under contention: every element arrives exactly once,
+// and each consumer sees the elements of one producer in the order they were pushed;
+// producer p pushes the sequence numbers [p * COUNT / k, (p + 1) * COUNT / k)
+static bool mpmc(const uint32_t k)
+{
+    static MpmcRingQueue<Element, 1024> queue;
+    std::unique_ptr<std::atomic<uint8_t>[]> received(new std::atomic<uint8_t>[COUNT]());
+    std::atomic<uint32_t> popped {0};
+    std::atomic<bool> ok {true};
+    const auto first = [k](const uint32_t p) { return (uint32_t)((uint64_t)COUNT * p / k); };
+    const auto begin = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < k; ++p)
+    {
+        threads.emplace_back([p, &first]
+        {
+            for (uint32_t i = first(p); i < first(p + 1); )
+            {
+                if (queue.push(Element { p, i, payload(p, i) })) ++i;
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (uint32_t c = 0; c < k; ++c)
+    {
+        threads.emplace_back([k, &first, &received, &popped, &ok]
+        {
+            std::vector<int64_t> last(k, -1);
+            Element e;
+            while (popped.load(std::memory_order_relaxed) < COUNT)
+            {
+                if (!queue.pop(e)) { std::this_thread::yield(); continue; }
+                popped.fetch_add(1, std::memory_order_relaxed);
+                if (e.producer >= k || e.seq < first(e.producer) || e.seq >= first(e.producer + 1)
+                    || !valid(e) || (int64_t)e.seq <= last[e.producer])
+                {
+                    ok = false;
+                    continue;
+                }
+                last[e.producer] = e.seq;
+                received[e.seq].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool result = ok && queue.empty();
+    for (uint32_t i = 0; i < COUNT; ++i)
+        if (received[i].load(std::memory_order_relaxed) != 1) result = false;
+    char name[32];
+    snprintf(name, sizeof(name), "MpmcRingQueue %u:%u", k, k);
+    report(name, COUNT, begin, result);
+    return result;
+}
+
+// bursty producer, parking consumer: nothing is lost across park / wake-up,
+// and a parked consumer is always woken (wait_pop_for() never times out)
+static bool blocking()
+{
+    static BlockingRingQueue<Element, 256> queue(100);
+    static const uint32_t BURST = 64;
+    static const uint32_t BURSTS = 2000;
+    bool ok = true;
+    const auto begin = std::chrono::steady_clock::now();
+
+    std::thread producer([]
+    {
+        uint32_t i = 0;
+        for (uint32_t b = 0; b < BURSTS; ++b)
+        {
+            for (uint32_t n = 0; n < BURST; )
+            {
+                if (queue.push(Element { 0, i, payload(0, i) })) { ++i; ++n; }
+                else std::this_thread::yield();
+            }
+            // let the consumer run dry and park every few bursts
+            if (b % 8 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    std::thread consumer([&ok]
+    {
+        Element e;
+        for (uint32_t i = 0; i < BURST * BURSTS; ++i)
+        {
+            if (!queue.wait_pop_for(e, std::chrono::seconds(1))) { ok = false; break; }
+            if (e.seq != i || !valid(e)) ok = false;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    ok = ok && queue.empty();
+    report("BlockingRingQueue 1:1 (bursts)", BURST * BURSTS, begin, ok);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t threads = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    bool ok = spsc();
+    for (uint32_t k = 1; k <= threads; ++k) ok &= mpmc(k);
+    ok &= blocking();
+    return ok ? 0 : 1;
+}
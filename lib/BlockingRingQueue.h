@@ -0,0 +1,140 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_BLOCKINGRINGQUEUE_H
+#define EMBEDDEDUTILS_BLOCKINGRINGQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include "SpscRingQueue.h"
+
+// SpscRingQueue with a blocking consumer for hosts (needs std::thread support)
+// - the consumer spins for spin_count polls, then parks on a condition variable
+// - the producer only takes the mutex when the consumer is parked,
+//   so push() stays free of syscalls while the consumer is busy
+template<typename T, size_t QUEUE_SIZE, typename size_type = uint32_t>
+class BlockingRingQueue
+{
+public:
+
+    explicit BlockingRingQueue(const uint32_t spin_count = 1000) : spin_count_(spin_count) {}
+
+    BlockingRingQueue(const BlockingRingQueue&) = delete;
+    BlockingRingQueue& operator= (const BlockingRingQueue&) = delete;
+
+    inline void setSpinCount(const uint32_t spin_count) { spin_count_.store(spin_count, std::memory_order_relaxed); }
+
+    inline size_type capacity() const { return queue_.capacity(); };
+    inline size_type size() const { return queue_.size(); };
+    inline bool empty() const { return queue_.empty(); };
+
+    // producer side
+
+    inline bool push(const T& data)
+    {
+        if (!queue_.push(data)) return false;
+        notify();
+        return true;
+    };
+    inline bool push(T&& data)
+    {
+        if (!queue_.push(std::move(data))) return false;
+        notify();
+        return true;
+    };
+
+    // consumer side
+
+    inline bool try_pop(T& data) { return queue_.pop(data); };
+
+    inline void wait_pop(T& data)
+    {
+        while (!queue_.pop(data)) wait(nullptr);
+    };
+
+    template <typename Rep, typename Period>
+    inline bool wait_pop_for(T& data, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!queue_.pop(data))
+            if (!wait(&deadline)) return false;
+        return true;
+    };
+
+    // waits for at least one element, then pops up to count without waiting further
+    inline size_type wait_pop_n(T* data, const size_type count)
+    {
+        if (count == 0) return 0;
+        while (queue_.empty()) wait(nullptr);
+        return pop_available(data, count);
+    };
+
+    template <typename Rep, typename Period>
+    inline size_type wait_pop_n_for(T* data, const size_type count, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        if (count == 0) return 0;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (queue_.empty())
+            if (!wait(&deadline)) return 0;
+        return pop_available(data, count);
+    };
+
+private:
+
+    using Clock = std::chrono::steady_clock;
+
+    inline size_type pop_available(T* data, const size_type count)
+    {
+        size_type n = 0;
+        while ((n < count) && queue_.pop(data[n])) ++n;
+        return n;
+    }
+
+    // the fence pairs with the one in wait(): either the producer sees parked_
+    // or the consumer sees the new element before it sleeps
+    inline void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    // returns false only on timeout
+    inline bool wait(const Clock::time_point* deadline)
+    {
+        const uint32_t spin_count = spin_count_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < spin_count; ++i)
+            if (!queue_.empty()) return true;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        parked_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ready = true;
+        while (queue_.empty())
+        {
+            if (!deadline) cv_.wait(lock);
+            else if (cv_.wait_until(lock, *deadline) == std::cv_status::timeout)
+            {
+                ready = !queue_.empty();
+                break;
+            }
+        }
+        parked_.store(false, std::memory_order_relaxed);
+        return ready;
+    }
+
+    SpscRingQueue<T, QUEUE_SIZE, size_type> queue_;
+    std::atomic<bool> parked_ {false};
+    std::atomic<uint32_t> spin_count_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+#endif // EMBEDDEDUTILS_BLOCKINGRINGQUEUE_H
@@ -0,0 +1,228 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_BROADCASTRING_H
+#define EMBEDDEDUTILS_BROADCASTRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "detail/CacheLine.h"
+#include "detail/RingQueueOverflow.h"
+#include "detail/RingSpan.h"
+
+// single-producer / multi-consumer ring where every consumer sees every element (disruptor style)
+// - elements are stored once; each of the CONSUMERS readers has its own cursor on its own cache line
+// - Reject / Block : push() gates on the slowest consumer, returning false or waiting while it is
+//   QUEUE_SIZE elements behind; the producer caches that cursor and rescans only when the ring looks full
+// - Overwrite      : push() never waits and a lagging consumer loses the oldest elements;
+//   pop() reports the gap through lost() and resumes at the oldest element still in the ring
+// - sequences are free-running 32bit counters, so the size must be a power of two
+template<typename T, size_t QUEUE_SIZE, size_t CONSUMERS, typename Overflow = RingQueueOverflow::Reject>
+class BroadcastRing
+{
+    static_assert((QUEUE_SIZE >= 2) && ((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0), "BroadcastRing size must be a power of two");
+    static_assert(CONSUMERS > 0, "BroadcastRing needs at least one consumer");
+
+    static constexpr bool OVERWRITE = std::is_same<Overflow, RingQueueOverflow::Overwrite>::value;
+    static constexpr uint32_t MASK = QUEUE_SIZE - 1;
+
+    // a consumer may read a slot while the producer overwrites it, so with Overwrite the slots
+    // are arrays of relaxed atomic words and elements are copied in and out through memcpy
+    static_assert(!OVERWRITE || std::is_trivially_copyable<T>::value, "BroadcastRing<Overwrite> elements must be trivially copyable");
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    struct Slot { std::atomic<uint32_t> words[WORDS]; };
+    using Storage = typename std::conditional<OVERWRITE, Slot, T>::type;
+
+public:
+    using ConstSpan = RingSpan<const T, size_t>;
+
+    BroadcastRing() {}
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator= (const BroadcastRing&) = delete;
+
+    inline size_t capacity() const { return QUEUE_SIZE; };
+    inline size_t consumers() const { return CONSUMERS; };
+
+    // producer side
+
+    inline bool push(const T& data)
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (!make_room(tail, Overflow())) return false;
+        write(tail, data);
+        return true;
+    };
+    inline bool push(T&& data)
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (!make_room(tail, Overflow())) return false;
+        write(tail, std::move(data));
+        return true;
+    };
+
+    // consumer side, each consumer passes its own index in [0, CONSUMERS)
+
+    // elements not yet read by consumer (may exceed capacity() with Overwrite, see lost())
+    inline size_t available(const size_t consumer) const
+    {
+        const Cursor& c = cursors_[consumer];
+        return tail_.load(std::memory_order_acquire) - c.head.load(std::memory_order_relaxed);
+    };
+    inline bool empty(const size_t consumer) const { return available(consumer) == 0; };
+
+    inline bool pop(const size_t consumer, T& data)
+    {
+        return pop(cursors_[consumer], data, Overflow());
+    };
+
+    // zero-copy read of the contiguous elements from the consumer's cursor, handed back with release()
+    // not available with Overwrite, since the producer may rewrite the slots while they are read
+    inline ConstSpan peek_span(const size_t consumer)
+    {
+        static_assert(!OVERWRITE, "BroadcastRing<Overwrite> has no zero-copy read");
+        Cursor& c = cursors_[consumer];
+        const uint32_t head = c.head.load(std::memory_order_relaxed);
+        const size_t first = head & MASK;
+        size_t n = readable(c, head);
+        if (n > QUEUE_SIZE - first) n = QUEUE_SIZE - first;
+        return ConstSpan { queue_ + first, n };
+    };
+    inline void release(const size_t consumer, size_t count)
+    {
+        static_assert(!OVERWRITE, "BroadcastRing<Overwrite> has no zero-copy read");
+        Cursor& c = cursors_[consumer];
+        const uint32_t head = c.head.load(std::memory_order_relaxed);
+        const size_t available = readable(c, head);
+        if (count > available) count = available;
+        c.head.store(head + (uint32_t)count, std::memory_order_release);
+    };
+
+    // skips everything published so far, e.g. when a consumer (re)starts
+    inline void resync(const size_t consumer)
+    {
+        Cursor& c = cursors_[consumer];
+        c.tail_cache = tail_.load(std::memory_order_acquire);
+        c.head.store(c.tail_cache, std::memory_order_release);
+    };
+
+    // elements the consumer missed because the producer overwrote them (Overwrite only)
+    inline uint32_t lost(const size_t consumer) const { return cursors_[consumer].lost; };
+
+private:
+
+    struct alignas(EMBEDDEDUTILS_CACHELINE_SIZE) Cursor
+    {
+        std::atomic<uint32_t> head {0};
+        uint32_t tail_cache {0};
+        uint32_t lost {0};
+    };
+
+    template <typename U>
+    inline void write(const uint32_t tail, U&& data)
+    {
+        store(tail, std::forward<U>(data), Overflow());
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+    template <typename U, typename Policy>
+    inline void store(const uint32_t tail, U&& data, Policy) { queue_[tail & MASK] = std::forward<U>(data); }
+
+    template <typename U>
+    inline void store(const uint32_t tail, U&& data, RingQueueOverflow::Overwrite)
+    {
+        const T& element = data;
+        uint32_t words[WORDS] = {};
+        memcpy(words, &element, sizeof(T));
+        // announce the slot before touching it, see pop(..., Overwrite)
+        claim_.store(tail + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = queue_[tail & MASK];
+        for (size_t i = 0; i < WORDS; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    // producer: free slots behind the slowest consumer, rescanning the cursors only when the cached one shows none
+    inline size_t writable(const uint32_t tail)
+    {
+        size_t n = QUEUE_SIZE - (uint32_t)(tail - gate_cache_);
+        if (n == 0)
+        {
+            uint32_t slowest = tail;
+            for (size_t i = 0; i < CONSUMERS; ++i)
+            {
+                const uint32_t head = cursors_[i].head.load(std::memory_order_acquire);
+                if ((uint32_t)(tail - head) > (uint32_t)(tail - slowest)) slowest = head;
+            }
+            gate_cache_ = slowest;
+            n = QUEUE_SIZE - (uint32_t)(tail - gate_cache_);
+        }
+        return n;
+    }
+
+    inline bool make_room(const uint32_t, RingQueueOverflow::Overwrite) { return true; }
+    inline bool make_room(const uint32_t tail, RingQueueOverflow::Reject) { return writable(tail) != 0; }
+    inline bool make_room(const uint32_t tail, RingQueueOverflow::Block)
+    {
+        while (writable(tail) == 0) Overflow::wait();
+        return true;
+    }
+
+    // consumer: readable elements from head, reloading tail_ only if the cached copy shows none
+    inline size_t readable(Cursor& c, const uint32_t head)
+    {
+        if (c.tail_cache == head) c.tail_cache = tail_.load(std::memory_order_acquire);
+        return (uint32_t)(c.tail_cache - head);
+    }
+
+    template <typename Policy>
+    inline bool pop(Cursor& c, T& data, Policy)
+    {
+        const uint32_t head = c.head.load(std::memory_order_relaxed);
+        if (readable(c, head) == 0) return false;
+        data = queue_[head & MASK];
+        c.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // seqlock-style read: copy the slot, then check that the producer has not claimed
+    // its next use in the meantime; if it has, count the element as lost and move on
+    inline bool pop(Cursor& c, T& data, RingQueueOverflow::Overwrite)
+    {
+        uint32_t words[WORDS];
+        uint32_t head = c.head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const uint32_t tail = tail_.load(std::memory_order_acquire);
+            if (tail == head) return false;
+            if ((uint32_t)(tail - head) > QUEUE_SIZE)
+            {
+                c.lost += (uint32_t)(tail - head) - QUEUE_SIZE;
+                head = tail - QUEUE_SIZE;
+            }
+            const Slot& slot = queue_[head & MASK];
+            for (size_t i = 0; i < WORDS; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((uint32_t)(claim_.load(std::memory_order_relaxed) - head) <= QUEUE_SIZE) break;
+            ++c.lost;
+            ++head;
+        }
+        memcpy(&data, words, sizeof(T));
+        c.head.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // written by the producer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<uint32_t> tail_ {0};
+    std::atomic<uint32_t> claim_ {0};
+    uint32_t gate_cache_ {0};
+
+    // one cache line per consumer
+    Cursor cursors_[CONSUMERS];
+
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) Storage queue_[QUEUE_SIZE];
+};
+
+#endif // EMBEDDEDUTILS_BROADCASTRING_H
@@ -0,0 +1,247 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_DYNAMICRINGQUEUE_H
+#define EMBEDDEDUTILS_DYNAMICRINGQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include "detail/RingIndex.h"
+#include "detail/RingCopy.h"
+#include "detail/RingSpan.h"
+
+// RingQueue whose capacity is set at construction
+// - storage comes from the caller (e.g. a static buffer sized from config at boot) or from Allocator
+// - the code is instantiated once per element type, not once per capacity;
+//   FixedRingQueue<T, N> below only adds inline storage on top of it
+// - push() overwrites the oldest element when full like RingQueue, try_push() rejects
+// - a queue constructed with capacity 0 stores nothing: every push returns false
+template<typename T, typename Allocator = std::allocator<T>>
+class DynamicRingQueue
+{
+public:
+    using Span = RingSpan<T, size_t>;
+    using Spans = RingSpans<T, size_t>;
+    using ConstSpans = RingSpans<const T, size_t>;
+    using iterator = RingIterator<T, size_t>;
+    using const_iterator = RingIterator<const T, size_t>;
+
+    // buffer is raw storage for capacity elements, suitably aligned for T, owned by the caller
+    DynamicRingQueue(T* buffer, const size_t capacity)
+    : index_(capacity), buffer_(buffer), owned_(false) {}
+
+    explicit DynamicRingQueue(const size_t capacity, const Allocator& allocator = Allocator())
+    : index_(capacity), allocator_(allocator), owned_(true)
+    {
+        buffer_ = std::allocator_traits<Allocator>::allocate(allocator_, capacity);
+    }
+
+    ~DynamicRingQueue()
+    {
+        clear();
+        if (owned_) std::allocator_traits<Allocator>::deallocate(allocator_, buffer_, index_.size());
+    }
+
+    DynamicRingQueue(const DynamicRingQueue&) = delete;
+    DynamicRingQueue& operator= (const DynamicRingQueue&) = delete;
+
+    inline size_t capacity() const { return index_.size(); };
+    inline size_t size() const { return index_.distance(tail_, head_); };
+    inline bool empty() const { return tail_ == head_; };
+    inline bool full() const { return size() == index_.size(); };
+    inline void clear() { destroy_front(size()); head_ = 0; tail_ = 0; };
+
+    inline void pop()
+    {
+        if (empty()) return;
+        const size_t head = head_;
+        buffer_[index_.slot(head)].~T();
+        head_ = index_.next(head);
+    };
+    inline bool pop(T& data)
+    {
+        if (empty()) return false;
+        data = std::move(buffer_[index_.slot(head_)]);
+        pop();
+        return true;
+    };
+
+    // push() / emplace() return false only if the element was not stored (capacity 0)
+    inline bool push(const T& data) { return emplace(data); };
+    inline bool push(T&& data) { return emplace(std::move(data)); };
+    template <typename... Args>
+    inline bool emplace(Args&&... args)
+    {
+        if (full())
+        {
+            if (empty()) return false;
+            pop();
+        }
+        construct_back(std::forward<Args>(args)...);
+        return true;
+    };
+
+    inline bool try_push(const T& data) { return try_emplace(data); };
+    inline bool try_push(T&& data) { return try_emplace(std::move(data)); };
+    template <typename... Args>
+    inline bool try_emplace(Args&&... args)
+    {
+        if (full()) return false;
+        construct_back(std::forward<Args>(args)...);
+        return true;
+    };
+
+    // double-ended operations; push_front() overwrites the newest element when full
+    inline bool push_front(const T& data) { return emplace_front(data); };
+    inline bool push_front(T&& data) { return emplace_front(std::move(data)); };
+    template <typename... Args>
+    inline bool emplace_front(Args&&... args)
+    {
+        if (full())
+        {
+            if (empty()) return false;
+            pop_back();
+        }
+        const size_t head = index_.prev(head_);
+        new (buffer_ + index_.slot(head)) T(std::forward<Args>(args)...);
+        head_ = head;
+        return true;
+    };
+    inline void pop_back()
+    {
+        if (empty()) return;
+        const size_t tail = index_.prev(tail_);
+        buffer_[index_.slot(tail)].~T();
+        tail_ = tail;
+    };
+    inline bool pop_back(T& data)
+    {
+        if (empty()) return false;
+        data = std::move(buffer_[index_.slot(index_.prev(tail_))]);
+        pop_back();
+        return true;
+    };
+
+    // bulk operations copy in at most two contiguous segments
+    // push_n() drops the oldest elements and keeps only the last capacity() if count exceeds it
+    inline size_t push_n(const T* data, size_t count)
+    {
+        const size_t cap = index_.size();
+        if (cap == 0) return 0;
+        const size_t pushed = count;
+        if (count > cap) { data += count - cap; count = cap; }
+        const size_t space = cap - size();
+        if (count > space) destroy_front(count - space);
+        const size_t tail = tail_;
+        const size_t first = index_.slot(tail);
+        const size_t contiguous = (cap - first < count) ? (cap - first) : count;
+        RingCopy::construct(buffer_ + first, data, contiguous);
+        RingCopy::construct(buffer_, data + contiguous, count - contiguous);
+        tail_ = index_.advance(tail, count);
+        return pushed;
+    }
+    inline size_t pop_n(T* data, size_t count)
+    {
+        const size_t head = head_;
+        const size_t available = index_.distance(tail_, head);
+        if (count > available) count = available;
+        const size_t first = index_.slot(head);
+        const size_t contiguous = (index_.size() - first < count) ? (index_.size() - first) : count;
+        RingCopy::relocate(data, buffer_ + first, contiguous);
+        RingCopy::relocate(data + contiguous, buffer_, count - contiguous);
+        head_ = index_.advance(head, count);
+        return count;
+    }
+
+    inline ConstSpans spans() const
+    {
+        const size_t head = head_;
+        const size_t first = index_.slot(head);
+        const size_t n = index_.distance(tail_, head);
+        const size_t contiguous = (n > index_.size() - first) ? (index_.size() - first) : n;
+        return ConstSpans { { buffer_ + first, contiguous }, { buffer_, n - contiguous } };
+    }
+    inline Spans spans()
+    {
+        const size_t head = head_;
+        const size_t first = index_.slot(head);
+        const size_t n = index_.distance(tail_, head);
+        const size_t contiguous = (n > index_.size() - first) ? (index_.size() - first) : n;
+        return Spans { { buffer_ + first, contiguous }, { buffer_, n - contiguous } };
+    }
+
+    inline const_iterator begin() const { return const_iterator(buffer_ + index_.slot(head_), buffer_, index_.size(), size()); }
+    inline const_iterator end() const { return const_iterator(); }
+    inline iterator begin() { return iterator(buffer_ + index_.slot(head_), buffer_, index_.size(), size()); }
+    inline iterator end() { return iterator(); }
+
+    inline const T& front() const { return buffer_[index_.slot(head_)]; };
+    inline T& front() { return buffer_[index_.slot(head_)]; };
+    inline const T& back() const { return buffer_[index_.slot(index_.prev(tail_))]; };
+    inline T& back() { return buffer_[index_.slot(index_.prev(tail_))]; };
+    inline const T& operator[] (const size_t index) const { return buffer_[index_.slot(head_, index)]; };
+    inline T& operator[] (const size_t index) { return buffer_[index_.slot(head_, index)]; };
+
+    // checked accessors: nullptr / false when the queue is empty
+    inline const T* front_ptr() const { return empty() ? nullptr : &front(); };
+    inline T* front_ptr() { return empty() ? nullptr : &front(); };
+    inline const T* back_ptr() const { return empty() ? nullptr : &back(); };
+    inline T* back_ptr() { return empty() ? nullptr : &back(); };
+    inline bool try_front(T& data) const
+    {
+        if (empty()) return false;
+        data = front();
+        return true;
+    };
+    inline bool try_back(T& data) const
+    {
+        if (empty()) return false;
+        data = back();
+        return true;
+    };
+
+private:
+
+    template <typename... Args>
+    inline void construct_back(Args&&... args)
+    {
+        const size_t tail = tail_;
+        new (buffer_ + index_.slot(tail)) T(std::forward<Args>(args)...);
+        tail_ = index_.next(tail);
+    }
+
+    inline void destroy_front(const size_t count)
+    {
+        const size_t head = head_;
+        const size_t first = index_.slot(head);
+        const size_t contiguous = (index_.size() - first < count) ? (index_.size() - first) : count;
+        RingCopy::destroy(buffer_ + first, contiguous);
+        RingCopy::destroy(buffer_, count - contiguous);
+        head_ = index_.advance(head, count);
+    }
+
+    RingIndex::Dynamic index_;
+    T* buffer_;
+    Allocator allocator_;
+    bool owned_;
+    volatile size_t head_ {0};
+    volatile size_t tail_ {0};
+};
+
+// fixed-size queue with inline storage, sharing DynamicRingQueue<T>'s code for every N
+template<typename T, size_t QUEUE_SIZE>
+class FixedRingQueue : public DynamicRingQueue<T>
+{
+    static_assert(QUEUE_SIZE > 0, "FixedRingQueue size must be greater than 0");
+
+public:
+    FixedRingQueue() : DynamicRingQueue<T>(reinterpret_cast<T*>(storage_), QUEUE_SIZE) {}
+    ~FixedRingQueue() { this->clear(); }
+
+private:
+    alignas(T) unsigned char storage_[sizeof(T) * QUEUE_SIZE];
+};
+
+#endif // EMBEDDEDUTILS_DYNAMICRINGQUEUE_H
@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_MPMCRINGQUEUE_H
+#define EMBEDDEDUTILS_MPMCRINGQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "detail/CacheLine.h"
+
+// bounded multi-producer / multi-consumer ring queue (D. Vyukov's per-slot sequence algorithm)
+// - every slot carries a sequence number which tells whether it is ready to be written or read,
+//   so producers only contend on tail_ and consumers only contend on head_ (one CAS each)
+// - push() / pop() never block and return false when the queue is full / empty
+// - front() is not provided: with several consumers the slot may be taken between peek and pop
+template<typename T, size_t QUEUE_SIZE>
+class MpmcRingQueue
+{
+    static_assert((QUEUE_SIZE >= 2) && ((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0), "MpmcRingQueue size must be a power of two");
+
+public:
+
+    MpmcRingQueue()
+    {
+        for (size_t i = 0; i < QUEUE_SIZE; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRingQueue(const MpmcRingQueue&) = delete;
+    MpmcRingQueue& operator= (const MpmcRingQueue&) = delete;
+
+    inline size_t capacity() const { return QUEUE_SIZE; };
+
+    // only a snapshot while other threads are running
+    inline size_t size() const
+    {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t n = tail - head;
+        return ((std::ptrdiff_t)n < 0) ? 0 : ((n > QUEUE_SIZE) ? QUEUE_SIZE : n);
+    };
+    inline bool empty() const { return size() == 0; };
+
+    inline bool push(const T& data)
+    {
+        Cell* cell = acquireWritable();
+        if (!cell) return false;
+        cell->data = data;
+        publish(cell);
+        return true;
+    };
+    inline bool push(T&& data)
+    {
+        Cell* cell = acquireWritable();
+        if (!cell) return false;
+        cell->data = std::move(data);
+        publish(cell);
+        return true;
+    };
+
+    inline bool pop(T& data)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;)
+        {
+            cell = &cells_[pos & MASK];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false;
+            else pos = head_.load(std::memory_order_relaxed);
+        }
+        data = std::move(cell->data);
+        cell->sequence.store(pos + QUEUE_SIZE, std::memory_order_release);
+        return true;
+    };
+
+private:
+
+    static constexpr size_t MASK = QUEUE_SIZE - 1;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    // claims the slot at tail_ and leaves its position in the sequence until publish()
+    inline Cell* acquireWritable()
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell* cell = &cells_[pos & MASK];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+            if (diff == 0)
+            {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return cell;
+            }
+            else if (diff < 0) return nullptr;
+            else pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    inline void publish(Cell* cell)
+    {
+        cell->sequence.store(cell->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) Cell cells_[QUEUE_SIZE];
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<size_t> tail_ {0};
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<size_t> head_ {0};
+};
+
+#endif // EMBEDDEDUTILS_MPMCRINGQUEUE_H
@@ -0,0 +1,169 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RECORDRING_H
+#define EMBEDDEDUTILS_RECORDRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "detail/CacheLine.h"
+#include "detail/RingIndex.h"
+#include "detail/RingSpan.h"
+
+// single-producer / single-consumer ring of variable-length records in one byte buffer
+// - each record is a length_type header followed by the payload, padded to the header alignment
+// - a record never wraps: if it does not fit before the end of the buffer, the rest is marked
+//   with a skip header and the record starts again at offset 0
+// - zero-copy on both sides: reserve(len) / commit() to write, read() / release() to consume
+template<size_t BUFFER_SIZE, typename length_type = uint16_t>
+class RecordRing
+{
+    using Index = RingIndex::Fixed<BUFFER_SIZE, uint32_t>;
+
+    static constexpr size_t HEADER_SIZE = sizeof(length_type);
+    static constexpr length_type SKIP = length_type(~length_type(0));
+
+    static_assert(BUFFER_SIZE % HEADER_SIZE == 0, "RecordRing size must be a multiple of the header size");
+
+public:
+    using ConstSpan = RingSpan<const uint8_t, size_t>;
+
+    // largest payload accepted by reserve()
+    // records up to half the buffer always fit once the ring drains, wherever the write position is
+    static constexpr size_t MAX_RECORD_SIZE = ((BUFFER_SIZE / 2 / HEADER_SIZE * HEADER_SIZE - HEADER_SIZE) < (size_t)(SKIP - 1))
+        ? (BUFFER_SIZE / 2 / HEADER_SIZE * HEADER_SIZE - HEADER_SIZE) : (size_t)(SKIP - 1);
+
+    inline size_t capacity() const { return BUFFER_SIZE; };
+    // bytes in use, including headers and padding
+    inline size_t size() const
+    {
+        return Index::distance(tail_.load(std::memory_order_acquire), head_.load(std::memory_order_acquire));
+    };
+    inline bool empty() const { return size() == 0; };
+
+    // producer side
+
+    // returns len writable bytes, or nullptr if the record does not fit now
+    // empty records are rejected: read() could not tell them from an empty ring
+    inline uint8_t* reserve(const size_t len)
+    {
+        if ((len == 0) || (len > MAX_RECORD_SIZE)) return nullptr;
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t pos = Index::slot(tail);
+        const size_t to_end = BUFFER_SIZE - pos;
+        const size_t space = BUFFER_SIZE - Index::distance(tail, head_.load(std::memory_order_acquire));
+        const size_t need = padded(len);
+        if (need <= to_end)
+        {
+            if (need > space) return nullptr;
+            reserved_skip_ = 0;
+            reserved_pos_ = pos;
+        }
+        else
+        {
+            if (to_end + need > space) return nullptr;
+            reserved_skip_ = to_end;
+            reserved_pos_ = 0;
+        }
+        reserved_len_ = len;
+        return buffer_ + reserved_pos_ + HEADER_SIZE;
+    };
+
+    // publishes the last reserved record, optionally shortened to len bytes; commit(0) drops it
+    inline void commit() { commit(reserved_len_); };
+    inline void commit(const size_t len)
+    {
+        if (len == 0)
+        {
+            reserved_len_ = 0;
+            return;
+        }
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (reserved_skip_) store_header(Index::slot(tail), SKIP);
+        store_header(reserved_pos_, (length_type)len);
+        tail_.store(Index::advance(tail, (uint32_t)(reserved_skip_ + padded(len))), std::memory_order_release);
+        reserved_len_ = 0;
+    };
+
+    inline bool push(const void* data, const size_t len)
+    {
+        uint8_t* p = reserve(len);
+        if (!p) return false;
+        memcpy(p, data, len);
+        commit(len);
+        return true;
+    };
+
+    // consumer side
+
+    // the oldest record (empty span if none); valid until release()
+    inline ConstSpan read()
+    {
+        uint32_t head;
+        if (!skip_to_record(head)) return ConstSpan { nullptr, 0 };
+        const size_t pos = Index::slot(head);
+        return ConstSpan { buffer_ + pos + HEADER_SIZE, load_header(pos) };
+    };
+
+    // drops the oldest record
+    inline void release()
+    {
+        uint32_t head;
+        if (!skip_to_record(head)) return;
+        head_.store(Index::advance(head, (uint32_t)padded(load_header(Index::slot(head)))), std::memory_order_release);
+    };
+
+    // copies the oldest record out; returns its length, or 0 if none or it does not fit in max_len
+    inline size_t pop(void* data, const size_t max_len)
+    {
+        const ConstSpan r = read();
+        if (r.empty() || (r.size > max_len)) return 0;
+        memcpy(data, r.data, r.size);
+        release();
+        return r.size;
+    };
+
+private:
+
+    static constexpr size_t padded(const size_t len)
+    {
+        return (HEADER_SIZE + len + HEADER_SIZE - 1) / HEADER_SIZE * HEADER_SIZE;
+    }
+
+    // moves head_ past a skip marker; false if there is no record
+    // the producer publishes a skip marker and the record after it in one commit
+    inline bool skip_to_record(uint32_t& head)
+    {
+        head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        const size_t pos = Index::slot(head);
+        if (load_header(pos) == SKIP)
+        {
+            head = Index::advance(head, (uint32_t)(BUFFER_SIZE - pos));
+            head_.store(head, std::memory_order_release);
+        }
+        return true;
+    }
+
+    inline void store_header(const size_t pos, const length_type len) { memcpy(buffer_ + pos, &len, HEADER_SIZE); }
+    inline length_type load_header(const size_t pos) const
+    {
+        length_type len;
+        memcpy(&len, buffer_ + pos, HEADER_SIZE);
+        return len;
+    }
+
+    // written by the producer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<uint32_t> tail_ {0};
+    size_t reserved_pos_ {0};
+    size_t reserved_skip_ {0};
+    size_t reserved_len_ {0};
+
+    // written by the consumer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<uint32_t> head_ {0};
+
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) uint8_t buffer_[BUFFER_SIZE];
+};
+
+#endif // EMBEDDEDUTILS_RECORDRING_H
@@ -1,75 +1,408 @@
-#pragma once
-
-#ifndef RINGQUEUE_H
-#define RINGQUEUE_H
-
-#include <cstddef>
-#include <exception>
-#include <type_traits>
-
-template<typename T, size_t QUEUE_SIZE, typename size_type = uint32_t>
-class RingQueue
-{
-public:
-    struct Exception : public std::exception {
-        Exception() {}
-        virtual const char *what() const noexcept {
-            return "RingQueue is Empty";
-        }
-    };
-
-    inline size_type capacity() const { return size_; };
-    inline size_type size() const { return (tail_ - head_); };
-    inline bool empty() const { return tail_ == head_; };
-    inline void clear() { head_ = 0; tail_ = 0; };
-    inline void pop()
-    {
-        if (size() == 0) return;
-        if (size() == 1) clear();
-        else head_++;
-    };
-    inline void push(const T& data)
-    {
-        queue_[(tail_++) % QUEUE_SIZE] = data;
-        if      (size() > QUEUE_SIZE) head_++;
-    };
-
-    inline const T& front() const throw(Exception)
-    {
-        if(empty()) throw Exception();
-        return *(queue_ + head_ % QUEUE_SIZE);
-    };
-    inline T front() throw(Exception)
-    {
-        if(empty()) throw Exception();
-        return *(queue_ + head_ % QUEUE_SIZE);
-    };
-
-    inline const T& back() const throw(Exception)
-    {
-        if(empty()) throw Exception();
-        return *(queue_ + (QUEUE_SIZE + tail_ - 1) % QUEUE_SIZE);
-    }
-    inline T back() throw(Exception)
-    {
-        if(empty()) throw Exception();
-        return *(queue_ + (QUEUE_SIZE + tail_ - 1) % QUEUE_SIZE);
-    }
-
-    inline const T& operator[] (const size_type index) const
-    {
-        return *(queue_ + (head_ + index) % QUEUE_SIZE);
-    }
-    inline T operator[] (const size_type index)
-    {
-        return *(queue_ + (head_ + index) % QUEUE_SIZE);
-    }
-
-private:
-
-    volatile size_type head_ {0};
-    volatile size_type tail_ {0};
-    T queue_[QUEUE_SIZE];
-};
-
-#endif
+#pragma once
+
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "detail/RingIndex.h"
+#include "detail/RingCopy.h"
+#include "detail/RingSpan.h"
+#include "detail/RingQueueOverflow.h"
+#include "detail/RingQueueStats.h"
+
+template<typename T, size_t QUEUE_SIZE, typename size_type = uint32_t,
+         typename Overflow = RingQueueOverflow::Overwrite, typename Stats = RingQueueStats::None>
+class RingQueue : private Stats
+{
+    using Index = RingIndex::Fixed<QUEUE_SIZE, size_type>;
+    using index_type = typename Overflow::template index_type<size_type>;
+
+public:
+    using Span = RingSpan<T, size_type>;
+    using ConstSpan = RingSpan<const T, size_type>;
+    using Spans = RingSpans<T, size_type>;
+    using ConstSpans = RingSpans<const T, size_type>;
+    using iterator = RingIterator<T, size_type>;
+    using const_iterator = RingIterator<const T, size_type>;
+
+    // copies and moves take the Stats counters of q along instead of counting the elements as new pushes
+    RingQueue() {}
+    RingQueue(const RingQueue& q) { for (const T& data : q) emplace(data); stats() = q.stats(); }
+    RingQueue(RingQueue&& q) { for (T& data : q) emplace(std::move(data)); stats() = q.stats(); q.clear(); }
+    ~RingQueue() { clear(); }
+
+    RingQueue& operator= (const RingQueue& q)
+    {
+        if (this != &q) { clear(); for (const T& data : q) emplace(data); stats() = q.stats(); }
+        return *this;
+    }
+    RingQueue& operator= (RingQueue&& q)
+    {
+        if (this != &q) { clear(); for (T& data : q) emplace(std::move(data)); stats() = q.stats(); q.clear(); }
+        return *this;
+    }
+
+    inline size_type capacity() const { return QUEUE_SIZE; };
+    inline size_type size() const { return Index::distance(tail_, head_); };
+    inline bool empty() const { return tail_ == head_; };
+    inline bool full() const { return size() == QUEUE_SIZE; };
+    inline void clear() { destroy_front(size()); head_ = 0; tail_ = 0; };
+
+    // counters of the Stats policy (e.g. RingQueueStats::Counters<>)
+    inline const Stats& stats() const { return *this; };
+    inline Stats& stats() { return *this; };
+
+    inline void pop()
+    {
+        if (empty()) return;
+        destroy_front();
+        Stats::on_pop(1);
+    };
+    // moves the front element out and destroys its slot
+    inline bool pop(T& data)
+    {
+        if (empty()) return false;
+        data = std::move(buffer()[Index::slot(head_)]);
+        pop();
+        return true;
+    };
+
+    // push() / emplace() follow the Overflow policy and return false only if the element was not stored
+    inline bool push(const T& data) { return emplace(data); };
+    inline bool push(T&& data) { return emplace(std::move(data)); };
+
+    // constructs the element in place
+    template <typename... Args>
+    inline bool emplace(Args&&... args)
+    {
+        if (!make_room(Overflow())) { Stats::on_drop(1); return false; }
+        construct_back(std::forward<Args>(args)...);
+        return true;
+    };
+
+    // never overwrites nor waits: false when full
+    inline bool try_push(const T& data) { return try_emplace(data); };
+    inline bool try_push(T&& data) { return try_emplace(std::move(data)); };
+    template <typename... Args>
+    inline bool try_emplace(Args&&... args)
+    {
+        if (full()) { Stats::on_drop(1); return false; }
+        construct_back(std::forward<Args>(args)...);
+        return true;
+    };
+
+    // double-ended operations, O(1) at both ends
+    // push_front() overwrites the newest element when full with Overwrite and returns false with Reject;
+    // not available with Block, since the front and back would no longer each have a single writer
+    inline bool push_front(const T& data) { return emplace_front(data); };
+    inline bool push_front(T&& data) { return emplace_front(std::move(data)); };
+    template <typename... Args>
+    inline bool emplace_front(Args&&... args)
+    {
+        if (!make_room_front(Overflow())) { Stats::on_drop(1); return false; }
+        construct_front(std::forward<Args>(args)...);
+        return true;
+    };
+    inline void pop_back()
+    {
+        if (empty()) return;
+        destroy_back();
+        Stats::on_pop(1);
+    };
+    // moves the back element out and destroys its slot
+    inline bool pop_back(T& data)
+    {
+        if (empty()) return false;
+        data = std::move(buffer()[Index::slot(Index::prev(tail_))]);
+        pop_back();
+        return true;
+    };
+
+#ifdef EMBEDDEDUTILS_RINGQUEUE_HAS_THREAD
+    // waits up to timeout for the consumer to make room (Block policy only)
+    template <typename Rep, typename Period>
+    inline bool push_for(const T& data, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        static_assert(std::is_same<Overflow, RingQueueOverflow::Block>::value, "push_for() needs RingQueueOverflow::Block");
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (full())
+        {
+            if (std::chrono::steady_clock::now() >= deadline) { Stats::on_drop(1); return false; }
+            Overflow::wait();
+        }
+        construct_back(data);
+        return true;
+    };
+#endif
+
+    // bulk operations copy in at most two contiguous segments
+    // push_n() follows the Overflow policy and returns the number of elements consumed from data
+    // - Overwrite : drops the oldest elements and keeps only the last QUEUE_SIZE if count exceeds the capacity
+    // - Reject    : stores as many as fit
+    // - Block     : waits until all are stored
+    inline size_type push_n(const T* data, const size_type count)
+    {
+        return push_n(data, count, Overflow());
+    }
+    inline size_type pop_n(T* data, size_type count)
+    {
+        const size_type head = head_;
+        const size_type available = Index::distance(tail_, head);
+        if (count > available) count = available;
+        const size_type first = Index::slot(head);
+        const size_type contiguous = (QUEUE_SIZE - first < count) ? (QUEUE_SIZE - first) : count;
+        RingCopy::relocate(data, buffer() + first, contiguous);
+        RingCopy::relocate(data + contiguous, buffer(), count - contiguous);
+        head_ = Index::advance(head, count);
+        Stats::on_pop(count);
+        return count;
+    }
+    inline size_type peek_n(T* data, size_type count) const
+    {
+        const size_type head = head_;
+        const size_type available = Index::distance(tail_, head);
+        if (count > available) count = available;
+        const size_type first = Index::slot(head);
+        const size_type contiguous = (QUEUE_SIZE - first < count) ? (QUEUE_SIZE - first) : count;
+        RingCopy::copy(data, buffer() + first, contiguous);
+        RingCopy::copy(data + contiguous, buffer(), count - contiguous);
+        return count;
+    }
+
+    // zero-copy access to the storage
+    // reserve() never overwrites: it returns only free slots (nullptr / empty span when full)
+    // and the slots are not part of the queue until commit()
+    // the slots are raw storage: a non-trivial T has to be constructed in them (placement new) before commit()
+    inline T* reserve()
+    {
+        const size_type tail = tail_;
+        if (Index::distance(tail, head_) == QUEUE_SIZE) return nullptr;
+        return buffer() + Index::slot(tail);
+    }
+    inline Span reserve(const size_type count)
+    {
+        const size_type tail = tail_;
+        const size_type first = Index::slot(tail);
+        size_type n = QUEUE_SIZE - Index::distance(tail, head_);
+        if (n > QUEUE_SIZE - first) n = QUEUE_SIZE - first;
+        if (n > count) n = count;
+        return Span { buffer() + first, n };
+    }
+    inline void commit(const size_type count = 1)
+    {
+        tail_ = Index::advance(tail_, count);
+        count_push(count);
+    }
+
+    // readable storage from front(), up to the end of the buffer
+    inline ConstSpan peek_span() const
+    {
+        const size_type head = head_;
+        const size_type first = Index::slot(head);
+        size_type n = Index::distance(tail_, head);
+        if (n > QUEUE_SIZE - first) n = QUEUE_SIZE - first;
+        return ConstSpan { buffer() + first, n };
+    }
+    inline Span peek_span()
+    {
+        const size_type head = head_;
+        const size_type first = Index::slot(head);
+        size_type n = Index::distance(tail_, head);
+        if (n > QUEUE_SIZE - first) n = QUEUE_SIZE - first;
+        return Span { buffer() + first, n };
+    }
+    inline void release(size_type count)
+    {
+        const size_type head = head_;
+        const size_type available = Index::distance(tail_, head);
+        if (count > available) count = available;
+        destroy_front(count);
+        Stats::on_pop(count);
+    }
+
+    // whole readable contents as at most two contiguous ranges, in queue order
+    inline ConstSpans spans() const
+    {
+        const size_type head = head_;
+        const size_type first = Index::slot(head);
+        const size_type n = Index::distance(tail_, head);
+        const size_type contiguous = (n > QUEUE_SIZE - first) ? (QUEUE_SIZE - first) : n;
+        return ConstSpans { { buffer() + first, contiguous }, { buffer(), (size_type)(n - contiguous) } };
+    }
+    inline Spans spans()
+    {
+        const size_type head = head_;
+        const size_type first = Index::slot(head);
+        const size_type n = Index::distance(tail_, head);
+        const size_type contiguous = (n > QUEUE_SIZE - first) ? (QUEUE_SIZE - first) : n;
+        return Spans { { buffer() + first, contiguous }, { buffer(), (size_type)(n - contiguous) } };
+    }
+
+    inline const_iterator begin() const { return const_iterator(buffer() + Index::slot(head_), buffer(), QUEUE_SIZE, size()); }
+    inline const_iterator end() const { return const_iterator(); }
+    inline iterator begin() { return iterator(buffer() + Index::slot(head_), buffer(), QUEUE_SIZE, size()); }
+    inline iterator end() { return iterator(); }
+
+    // unchecked accessors: the queue must not be empty (or index must be less than size())
+    inline const T& front() const { return buffer()[Index::slot(head_)]; };
+    inline T& front() { return buffer()[Index::slot(head_)]; };
+    inline const T& back() const { return buffer()[Index::slot(Index::prev(tail_))]; };
+    inline T& back() { return buffer()[Index::slot(Index::prev(tail_))]; };
+    inline const T& operator[] (const size_type index) const { return buffer()[Index::slot(head_, index)]; };
+    inline T& operator[] (const size_type index) { return buffer()[Index::slot(head_, index)]; };
+
+    // checked accessors: nullptr / false when the queue is empty
+    inline const T* front_ptr() const { return empty() ? nullptr : &front(); };
+    inline T* front_ptr() { return empty() ? nullptr : &front(); };
+    inline const T* back_ptr() const { return empty() ? nullptr : &back(); };
+    inline T* back_ptr() { return empty() ? nullptr : &back(); };
+    inline bool try_front(T& data) const
+    {
+        if (empty()) return false;
+        data = front();
+        return true;
+    };
+    inline bool try_back(T& data) const
+    {
+        if (empty()) return false;
+        data = back();
+        return true;
+    };
+
+private:
+
+    inline T* buffer() { return reinterpret_cast<T*>(storage_); }
+    inline const T* buffer() const { return reinterpret_cast<const T*>(storage_); }
+
+    template <typename... Args>
+    inline void construct_back(Args&&... args)
+    {
+        const size_type tail = tail_;
+        new (buffer() + Index::slot(tail)) T(std::forward<Args>(args)...);
+        tail_ = Index::next(tail);
+        count_push(1);
+    }
+
+    template <typename... Args>
+    inline void construct_front(Args&&... args)
+    {
+        const size_type head = Index::prev(head_);
+        new (buffer() + Index::slot(head)) T(std::forward<Args>(args)...);
+        head_ = head;
+        count_push(1);
+    }
+
+    inline bool make_room(RingQueueOverflow::Overwrite)
+    {
+        if (full()) { destroy_front(); Stats::on_overwrite(1); }
+        return true;
+    }
+    inline bool make_room(RingQueueOverflow::Reject)
+    {
+        return !full();
+    }
+    inline bool make_room(RingQueueOverflow::Block)
+    {
+        while (full()) Overflow::wait();
+        return true;
+    }
+
+    inline bool make_room_front(RingQueueOverflow::Overwrite)
+    {
+        if (full()) { destroy_back(); Stats::on_overwrite(1); }
+        return true;
+    }
+    inline bool make_room_front(RingQueueOverflow::Reject)
+    {
+        return !full();
+    }
+    inline bool make_room_front(RingQueueOverflow::Block)
+    {
+        static_assert(!std::is_same<Overflow, RingQueueOverflow::Block>::value, "push_front() is not available with RingQueueOverflow::Block");
+        return false;
+    }
+
+    // count must fit in the free space
+    inline void construct_back_n(const T* data, const size_type count)
+    {
+        const size_type tail = tail_;
+        const size_type first = Index::slot(tail);
+        const size_type contiguous = (QUEUE_SIZE - first < count) ? (QUEUE_SIZE - first) : count;
+        RingCopy::construct(buffer() + first, data, contiguous);
+        RingCopy::construct(buffer(), data + contiguous, count - contiguous);
+        tail_ = Index::advance(tail, count);
+        count_push(count);
+    }
+
+    inline size_type push_n(const T* data, size_type count, RingQueueOverflow::Overwrite)
+    {
+        const size_type pushed = count;
+        if (count > QUEUE_SIZE) { data += count - QUEUE_SIZE; count = QUEUE_SIZE; }
+        const size_type space = QUEUE_SIZE - size();
+        if (count > space) destroy_front(count - space);
+        if (pushed > space) Stats::on_overwrite(pushed - space);
+        construct_back_n(data, count);
+        return pushed;
+    }
+    inline size_type push_n(const T* data, size_type count, RingQueueOverflow::Reject)
+    {
+        const size_type space = QUEUE_SIZE - size();
+        if (count > space) { Stats::on_drop(count - space); count = space; }
+        construct_back_n(data, count);
+        return count;
+    }
+    inline size_type push_n(const T* data, const size_type count, RingQueueOverflow::Block)
+    {
+        size_type pushed = 0;
+        while (pushed < count)
+        {
+            size_type n = QUEUE_SIZE - size();
+            if (n == 0) { Overflow::wait(); continue; }
+            if (n > count - pushed) n = count - pushed;
+            construct_back_n(data + pushed, n);
+            pushed += n;
+        }
+        return pushed;
+    }
+
+    inline void count_push(const size_type count)
+    {
+        // size() reads the volatile indices, so keep it out of builds without stats
+        if (Stats::ENABLED && count) Stats::on_push(count, size(), QUEUE_SIZE);
+    }
+
+    inline void destroy_front()
+    {
+        const size_type head = head_;
+        buffer()[Index::slot(head)].~T();
+        head_ = Index::next(head);
+    }
+
+    inline void destroy_back()
+    {
+        const size_type tail = Index::prev(tail_);
+        buffer()[Index::slot(tail)].~T();
+        tail_ = tail;
+    }
+
+    inline void destroy_front(const size_type count)
+    {
+        const size_type head = head_;
+        const size_type first = Index::slot(head);
+        const size_type contiguous = (QUEUE_SIZE - first < count) ? (QUEUE_SIZE - first) : count;
+        RingCopy::destroy(buffer() + first, contiguous);
+        RingCopy::destroy(buffer(), count - contiguous);
+        head_ = Index::advance(head, count);
+    }
+
+    index_type head_ {0};
+    index_type tail_ {0};
+    // elements are constructed on push and destroyed on pop, so T needs no default constructor
+    alignas(T) unsigned char storage_[sizeof(T) * QUEUE_SIZE];
+};
+
+#endif
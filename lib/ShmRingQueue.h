@@ -0,0 +1,150 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_SHMRINGQUEUE_H
+#define EMBEDDEDUTILS_SHMRINGQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SpscRingQueue.h"
+
+// SpscRingQueue living in POSIX shared memory (shm_open or memfd + mmap), for hosts
+// - one process creates the region, another attaches to it; after that push() / pop() never enter the kernel
+// - the region holds only indices and elements (no pointers), so it may be mapped at any address
+// - the header is stamped with a magic number after the queue is initialized, and attach() checks it
+//   together with the layout and the index invariants, so a region left by a crashed creator or
+//   built with a different T / capacity / cache line size is refused
+template<typename T, size_t QUEUE_SIZE>
+class ShmRingQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "ShmRingQueue elements must be trivially copyable");
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "ShmRingQueue needs lock-free 32bit atomics");
+
+public:
+    using Queue = SpscRingQueue<T, QUEUE_SIZE, uint32_t>;
+
+    ShmRingQueue() {}
+    ~ShmRingQueue() { detach(); }
+
+    ShmRingQueue(const ShmRingQueue&) = delete;
+    ShmRingQueue& operator= (const ShmRingQueue&) = delete;
+
+    // creates (or re-initializes) the named region, e.g. "/sensor_queue"
+    bool create(const char* name)
+    {
+        const int fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+        if (fd < 0) return false;
+        const bool b = create(fd);
+        ::close(fd);
+        return b;
+    }
+
+    // initializes the region on an already opened fd (e.g. from memfd_create())
+    bool create(const int fd)
+    {
+        detach();
+        if (ftruncate(fd, (off_t)REGION_SIZE) != 0) return false;
+        if (!map(fd)) return false;
+
+        Header* h = header();
+        h->magic.store(0, std::memory_order_relaxed);
+        h->version = VERSION;
+        h->element_size = sizeof(T);
+        h->capacity = QUEUE_SIZE;
+        h->queue_size = sizeof(Queue);
+        h->region_size = REGION_SIZE;
+        new (queue_) Queue();
+        h->magic.store(MAGIC, std::memory_order_release);
+        return true;
+    }
+
+    bool attach(const char* name)
+    {
+        const int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0) return false;
+        const bool b = attach(fd);
+        ::close(fd);
+        return b;
+    }
+
+    bool attach(const int fd)
+    {
+        detach();
+        struct stat st;
+        if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < REGION_SIZE)) return false;
+        if (!map(fd)) return false;
+        if (!validate()) { detach(); return false; }
+        return true;
+    }
+
+    void detach()
+    {
+        if (region_) munmap(region_, REGION_SIZE);
+        region_ = nullptr;
+        queue_ = nullptr;
+    }
+
+    static bool unlink(const char* name) { return shm_unlink(name) == 0; }
+
+    inline bool attached() const { return queue_ != nullptr; }
+
+    // header matches this build and the indices are consistent
+    bool validate() const
+    {
+        if (!region_) return false;
+        const Header* h = header();
+        return (h->magic.load(std::memory_order_acquire) == MAGIC)
+            && (h->version == VERSION)
+            && (h->element_size == sizeof(T))
+            && (h->capacity == QUEUE_SIZE)
+            && (h->queue_size == sizeof(Queue))
+            && (h->region_size == REGION_SIZE)
+            && queue_->valid();
+    }
+
+    // push() from the producer process, pop() / front() from the consumer process
+    inline Queue& queue() { return *queue_; }
+    inline const Queue& queue() const { return *queue_; }
+    inline Queue* operator-> () { return queue_; }
+    inline const Queue* operator-> () const { return queue_; }
+
+private:
+
+    struct Header
+    {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t element_size;
+        uint32_t capacity;
+        uint64_t queue_size;
+        uint64_t region_size;
+    };
+
+    static constexpr uint32_t MAGIC = 0x52515348; // "RQSH"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t QUEUE_OFFSET = (sizeof(Header) + alignof(Queue) - 1) / alignof(Queue) * alignof(Queue);
+    static constexpr size_t REGION_SIZE = QUEUE_OFFSET + sizeof(Queue);
+
+    inline Header* header() { return reinterpret_cast<Header*>(region_); }
+    inline const Header* header() const { return reinterpret_cast<const Header*>(region_); }
+
+    bool map(const int fd)
+    {
+        void* p = mmap(nullptr, REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return false;
+        region_ = static_cast<unsigned char*>(p);
+        queue_ = reinterpret_cast<Queue*>(region_ + QUEUE_OFFSET);
+        return true;
+    }
+
+    unsigned char* region_ {nullptr};
+    Queue* queue_ {nullptr};
+};
+
+#endif // EMBEDDEDUTILS_SHMRINGQUEUE_H
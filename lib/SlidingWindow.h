@@ -0,0 +1,169 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_SLIDINGWINDOW_H
+#define EMBEDDEDUTILS_SLIDINGWINDOW_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "RingQueue.h"
+
+// last WINDOW_SIZE samples with sum / mean / variance / min / max in amortized O(1) per push
+// - sum and sum of squares are kept as compensated (Kahan-Neumaier) running sums, updated on push
+//   and evict, so they do not drift over millions of samples
+// - both sums are taken relative to a shift close to the mean, which keeps variance exact when the
+//   mean is large compared to the spread (e.g. raw pressure or temperature readings); every
+//   WINDOW_SIZE pushes the shift moves to the current mean and the sums are rebuilt from the samples,
+//   so a drifting signal never strays far from it (O(N) once per window, still amortized O(1))
+// - min / max come from monotonic deques: each sample enters and leaves each deque at most once
+// - acc_type defaults to T for floating point samples and to double for integer samples
+template<typename T, size_t WINDOW_SIZE,
+    typename acc_type = typename std::conditional<std::is_floating_point<T>::value, T, double>::type>
+class SlidingWindow
+{
+    static_assert(std::is_arithmetic<T>::value, "SlidingWindow needs arithmetic samples");
+    static_assert(std::is_floating_point<acc_type>::value, "SlidingWindow needs a floating point accumulator");
+    static_assert(WINDOW_SIZE > 0, "SlidingWindow needs a non-empty window");
+
+public:
+    using Samples = RingQueue<T, WINDOW_SIZE, uint32_t>;
+
+    inline size_t capacity() const { return WINDOW_SIZE; };
+    inline size_t size() const { return samples_.size(); };
+    inline bool empty() const { return samples_.empty(); };
+    inline bool full() const { return samples_.full(); };
+
+    inline void clear()
+    {
+        samples_.clear();
+        min_.clear();
+        max_.clear();
+        sum_.clear();
+        sum_sq_.clear();
+        shift_ = 0;
+        pushes_ = 0;
+    };
+
+    // adds a sample, evicting the oldest one once the window is full
+    inline void push(const T& data)
+    {
+        if (samples_.full()) evict();
+        if (samples_.empty()) shift_ = (acc_type)data;
+
+        const acc_type d = (acc_type)data - shift_;
+        sum_.add(d);
+        sum_sq_.add(d * d);
+        min_.push(data);
+        max_.push(data);
+        samples_.push(data);
+        if (++pushes_ == WINDOW_SIZE) rebase();
+    };
+
+    inline acc_type sum() const { return shift_ * (acc_type)size() + sum_.value(); };
+    inline acc_type mean() const { return empty() ? acc_type(0) : shift_ + sum_.value() / (acc_type)size(); };
+
+    // population variance of the samples in the window
+    inline acc_type variance() const
+    {
+        if (empty()) return acc_type(0);
+        const acc_type n = (acc_type)size();
+        const acc_type s = sum_.value();
+        const acc_type v = (sum_sq_.value() - s * s / n) / n;
+        return (v > acc_type(0)) ? v : acc_type(0);
+    };
+    inline acc_type stddev() const { return std::sqrt(variance()); };
+
+    // undefined on an empty window
+    inline const T& min() const { return min_.front(); };
+    inline const T& max() const { return max_.front(); };
+
+    // the samples themselves, oldest first
+    inline const Samples& samples() const { return samples_; };
+
+private:
+
+    struct Compensated
+    {
+        acc_type sum {0};
+        acc_type c {0};
+
+        inline void add(const acc_type v)
+        {
+            const acc_type t = sum + v;
+            if (magnitude(sum) >= magnitude(v)) c += (sum - t) + v;
+            else c += (v - t) + sum;
+            sum = t;
+        }
+        inline acc_type value() const { return sum + c; }
+        inline void clear() { sum = 0; c = 0; }
+
+        static inline acc_type magnitude(const acc_type v) { return (v < acc_type(0)) ? -v : v; }
+    };
+
+    // values in queue order where each one is kept only while no later value beats it,
+    // so front() is always the extremum of the window (minimum if KEEP_MIN, else maximum)
+    template <bool KEEP_MIN>
+    class Monotonic
+    {
+    public:
+        inline void push(const T& data)
+        {
+            while (!deque_.empty() && beaten(back(), data)) deque_.pop_back();
+            deque_.push(data);
+        }
+        // called with the sample leaving the window; equal values are kept in the deque,
+        // so an equal front is that very sample and anything else was already beaten
+        inline void evict(const T& data)
+        {
+            if (!deque_.empty() && (front() == data)) deque_.pop();
+        }
+        inline const T& front() const { return deque_.front(); }
+        inline void clear() { deque_.clear(); }
+
+    private:
+        inline const T& back() const { return deque_.back(); }
+        static inline bool beaten(const T& old_value, const T& new_value)
+        {
+            return KEEP_MIN ? (new_value < old_value) : (old_value < new_value);
+        }
+
+        RingQueue<T, WINDOW_SIZE, uint32_t> deque_;
+    };
+
+    inline void evict()
+    {
+        const T oldest = samples_.front();
+        const acc_type d = (acc_type)oldest - shift_;
+        sum_.add(-d);
+        sum_sq_.add(-(d * d));
+        min_.evict(oldest);
+        max_.evict(oldest);
+        samples_.pop();
+    }
+
+    // moves the shift to the current mean and rebuilds both sums from the samples
+    inline void rebase()
+    {
+        pushes_ = 0;
+        shift_ = mean();
+        sum_.clear();
+        sum_sq_.clear();
+        for (const T& data : samples_)
+        {
+            const acc_type d = (acc_type)data - shift_;
+            sum_.add(d);
+            sum_sq_.add(d * d);
+        }
+    }
+
+    Samples samples_;
+    Monotonic<true> min_;
+    Monotonic<false> max_;
+    Compensated sum_;
+    Compensated sum_sq_;
+    acc_type shift_ {0};
+    size_t pushes_ {0};
+};
+
+#endif // EMBEDDEDUTILS_SLIDINGWINDOW_H
@@ -0,0 +1,172 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_SPSCRINGQUEUE_H
+#define EMBEDDEDUTILS_SPSCRINGQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "detail/CacheLine.h"
+#include "detail/RingIndex.h"
+#include "detail/RingSpan.h"
+
+// lock-free single-producer / single-consumer ring queue
+// - push() is called only from the producer (e.g. ISR), pop() / front() only from the consumer
+// - the producer owns tail_, the consumer owns head_; each side only reads the other's index
+// - push() never overwrites: it returns false when the queue is full
+// - full and empty are told apart by the index range (see RingIndex), so no slot is left unused
+// - head_ and tail_ live on separate cache lines, and each side keeps a cached copy of the other's
+//   index so that the shared one is reloaded only when the queue looks full (producer) or empty (consumer)
+template<typename T, size_t QUEUE_SIZE, typename size_type = uint32_t>
+class SpscRingQueue
+{
+    using Index = RingIndex::Fixed<QUEUE_SIZE, size_type>;
+
+public:
+    using Span = RingSpan<T, size_type>;
+
+    inline size_type capacity() const { return QUEUE_SIZE; };
+    inline size_type size() const
+    {
+        return Index::distance(tail_.load(std::memory_order_acquire), head_.load(std::memory_order_acquire));
+    };
+    inline bool empty() const { return size() == 0; };
+    inline bool full() const { return size() == QUEUE_SIZE; };
+
+    // indices are in range and no further apart than the capacity
+    // (e.g. to check a queue left in shared memory by another process)
+    inline bool valid() const
+    {
+        const size_type head = head_.load(std::memory_order_acquire);
+        const size_type tail = tail_.load(std::memory_order_acquire);
+        return Index::valid(head) && Index::valid(tail) && (Index::distance(tail, head) <= QUEUE_SIZE);
+    };
+
+    // producer side
+
+    inline bool push(const T& data)
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) return false;
+        queue_[Index::slot(tail)] = data;
+        tail_.store(Index::next(tail), std::memory_order_release);
+        return true;
+    };
+    inline bool push(T&& data)
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) return false;
+        queue_[Index::slot(tail)] = std::move(data);
+        tail_.store(Index::next(tail), std::memory_order_release);
+        return true;
+    };
+
+    // zero-copy write: fill the returned slots, then publish them with commit()
+    inline T* reserve()
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) return nullptr;
+        return queue_ + Index::slot(tail);
+    };
+    inline Span reserve(const size_type count)
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        const size_type first = Index::slot(tail);
+        const size_type contiguous = (QUEUE_SIZE - first < count) ? (QUEUE_SIZE - first) : count;
+        size_type n = writable(tail, contiguous);
+        if (n > contiguous) n = contiguous;
+        return Span { queue_ + first, n };
+    };
+    inline void commit(const size_type count = 1)
+    {
+        tail_.store(Index::advance(tail_.load(std::memory_order_relaxed), count), std::memory_order_release);
+    };
+
+    // consumer side
+
+    inline const T& front() const
+    {
+        return queue_[Index::slot(head_.load(std::memory_order_relaxed))];
+    };
+    inline T& front()
+    {
+        return queue_[Index::slot(head_.load(std::memory_order_relaxed))];
+    };
+
+    inline void pop()
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (readable(head, 1) == 0) return;
+        head_.store(Index::next(head), std::memory_order_release);
+    };
+    inline bool pop(T& data)
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (readable(head, 1) == 0) return false;
+        data = std::move(queue_[Index::slot(head)]);
+        head_.store(Index::next(head), std::memory_order_release);
+        return true;
+    };
+
+    // zero-copy read: the contiguous readable slots from front(), handed back with release()
+    inline Span peek_span()
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type first = Index::slot(head);
+        size_type n = readable(head, QUEUE_SIZE - first);
+        if (n > QUEUE_SIZE - first) n = QUEUE_SIZE - first;
+        return Span { queue_ + first, n };
+    };
+    inline void release(size_type count)
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type available = readable(head, count);
+        if (count > available) count = available;
+        head_.store(Index::advance(head, count), std::memory_order_release);
+    };
+
+    inline void clear()
+    {
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        head_.store(tail_cache_, std::memory_order_release);
+    };
+
+private:
+
+    // producer: free slots from tail, reloading head_ only if the cached copy shows fewer than needed
+    inline size_type writable(const size_type tail, const size_type needed)
+    {
+        size_type n = QUEUE_SIZE - Index::distance(tail, head_cache_);
+        if (n < needed)
+        {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            n = QUEUE_SIZE - Index::distance(tail, head_cache_);
+        }
+        return n;
+    }
+
+    // consumer: readable slots from head, reloading tail_ only if the cached copy shows fewer than needed
+    inline size_type readable(const size_type head, const size_type needed)
+    {
+        size_type n = Index::distance(tail_cache_, head);
+        if (n < needed)
+        {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            n = Index::distance(tail_cache_, head);
+        }
+        return n;
+    }
+
+    // written by the producer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<size_type> tail_ {0};
+    size_type head_cache_ {0};
+
+    // written by the consumer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<size_type> head_ {0};
+    size_type tail_cache_ {0};
+
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) T queue_[QUEUE_SIZE];
+};
+
+#endif // EMBEDDEDUTILS_SPSCRINGQUEUE_H
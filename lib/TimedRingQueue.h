@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_TIMEDRINGQUEUE_H
+#define EMBEDDEDUTILS_TIMEDRINGQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "RingQueue.h"
+
+// RingQueue of (time, value) samples that keeps only the last horizon time units
+// - push(now, value) and window(now) drop every sample older than now - horizon;
+//   QUEUE_SIZE still bounds the count, and the oldest sample is overwritten when it is full
+// - time_type is an unsigned tick counter like millis() / micros() and may wrap,
+//   as long as the samples in the queue span less than half its range
+// - samples are in time order, so since(t) binary searches the two contiguous segments in O(log N)
+template<typename T, size_t QUEUE_SIZE, typename time_type = uint32_t>
+class TimedRingQueue
+{
+    static_assert(std::is_unsigned<time_type>::value, "TimedRingQueue needs an unsigned (wrapping) time type");
+
+    using diff_type = typename std::make_signed<time_type>::type;
+
+public:
+    struct Sample
+    {
+        time_type time;
+        T value;
+    };
+
+    using Queue = RingQueue<Sample, QUEUE_SIZE, uint32_t>;
+    using ConstSpan = RingSpan<const Sample, uint32_t>;
+    using ConstSpans = RingSpans<const Sample, uint32_t>;
+
+    explicit TimedRingQueue(const time_type horizon) : horizon_(horizon) {}
+
+    inline void setHorizon(const time_type horizon) { horizon_ = horizon; }
+    inline time_type horizon() const { return horizon_; }
+
+    inline size_t capacity() const { return queue_.capacity(); };
+    inline size_t size() const { return queue_.size(); };
+    inline bool empty() const { return queue_.empty(); };
+    inline bool full() const { return queue_.full(); };
+    inline void clear() { queue_.clear(); };
+
+    // time must not go backwards between pushes
+    inline void push(const time_type time, const T& value)
+    {
+        evict(time);
+        queue_.emplace(Sample { time, value });
+    };
+    inline void push(const time_type time, T&& value)
+    {
+        evict(time);
+        queue_.emplace(Sample { time, std::move(value) });
+    };
+
+    // drops the samples older than now - horizon; returns how many were dropped
+    inline size_t evict(const time_type now)
+    {
+        size_t n = 0;
+        while (!queue_.empty() && ((time_type)(now - samples().front().time) > horizon_))
+        {
+            queue_.pop();
+            ++n;
+        }
+        return n;
+    };
+
+    // samples within the horizon at now, oldest first
+    inline ConstSpans window(const time_type now)
+    {
+        evict(now);
+        return samples().spans();
+    };
+
+    // index of the first sample taken at or after time (size() if none)
+    inline size_t lower_bound(const time_type time) const
+    {
+        const ConstSpans s = queue_.spans();
+        const size_t i = lower_bound(s.first, time);
+        if (i < s.first.size) return i;
+        return s.first.size + lower_bound(s.second, time);
+    };
+
+    // samples taken at or after time, oldest first; no eviction
+    inline ConstSpans since(const time_type time) const
+    {
+        const ConstSpans s = queue_.spans();
+        const uint32_t i = (uint32_t)lower_bound(time);
+        if (i < s.first.size)
+            return ConstSpans { { s.first.data + i, (uint32_t)(s.first.size - i) }, s.second };
+        const uint32_t j = i - s.first.size;
+        return ConstSpans { { s.second.data + j, (uint32_t)(s.second.size - j) }, { s.second.data + s.second.size, 0 } };
+    };
+    inline size_t count_since(const time_type time) const { return size() - lower_bound(time); };
+
+    inline const Queue& samples() const { return queue_; };
+
+private:
+
+    static inline size_t lower_bound(const ConstSpan& span, const time_type time)
+    {
+        const Sample* it = std::lower_bound(span.begin(), span.end(), time,
+            [](const Sample& s, const time_type t) { return (diff_type)(s.time - t) < 0; });
+        return (size_t)(it - span.begin());
+    }
+
+    Queue queue_;
+    time_type horizon_;
+};
+
+#endif // EMBEDDEDUTILS_TIMEDRINGQUEUE_H
@@ -0,0 +1,102 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_TRIPLEBUFFER_H
+#define EMBEDDEDUTILS_TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include "detail/CacheLine.h"
+
+// wait-free single-writer / single-reader "latest value" channel
+// - the writer fills its own buffer and swaps it with the shared middle one, the reader swaps
+//   the middle one with its own buffer when it is newer; neither side ever waits for the other
+// - the reader always sees a complete T (no tearing, whatever its size) and the newest one
+//   published before update(); older unread values are simply replaced
+// - use it instead of a queue when only the current sample matters, e.g. state for a control loop
+template<typename T>
+class TripleBuffer
+{
+public:
+
+    TripleBuffer() {}
+    explicit TripleBuffer(const T& initial)
+    {
+        for (uint8_t i = 0; i < 3; ++i) buffers_[i].data = initial;
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator= (const TripleBuffer&) = delete;
+
+    // writer side
+
+    inline void write(const T& data)
+    {
+        buffers_[back_].data = data;
+        publish();
+    };
+    inline void write(T&& data)
+    {
+        buffers_[back_].data = std::move(data);
+        publish();
+    };
+
+    // in-place write: fill back() (it still holds an older value), then publish() it
+    inline T& back() { return buffers_[back_].data; };
+    inline void publish()
+    {
+        back_ = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & INDEX;
+    };
+
+    // reader side
+
+    // a value was published since the last update()
+    inline bool fresh() const { return (middle_.load(std::memory_order_relaxed) & DIRTY) != 0; };
+
+    // takes the newest published value, if any; returns whether front() changed
+    inline bool update()
+    {
+        if (!fresh()) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    };
+
+    // the value taken by the last update(), stable until the next one
+    inline const T& front() const { return buffers_[front_].data; };
+
+    inline const T& read()
+    {
+        update();
+        return front();
+    };
+    // copies the newest value out; false if nothing new was published since the last read
+    inline bool read(T& data)
+    {
+        if (!update()) return false;
+        data = buffers_[front_].data;
+        return true;
+    };
+
+private:
+
+    static constexpr uint8_t INDEX = 0x03;
+    static constexpr uint8_t DIRTY = 0x04;
+
+    struct alignas(EMBEDDEDUTILS_CACHELINE_SIZE) Buffer
+    {
+        T data {};
+    };
+
+    Buffer buffers_[3];
+
+    // index of the shared buffer and whether it holds an unread value, swapped by both sides
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) std::atomic<uint8_t> middle_ {1};
+
+    // owned by the writer
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) uint8_t back_ {0};
+
+    // owned by the reader
+    alignas(EMBEDDEDUTILS_CACHELINE_SIZE) uint8_t front_ {2};
+};
+
+#endif // EMBEDDEDUTILS_TRIPLEBUFFER_H
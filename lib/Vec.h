@@ -5,6 +5,11 @@
 #include "detail/Macro.h"
 #include "detail/Vec2f.h"
 #include "detail/Vec3f.h"
+#include "detail/Vec3fA.h"
 #include "detail/Vec4f.h"
+#include "detail/Rotation.h"
+#ifndef __AVR__
+#include "detail/VecArray.h"
+#endif
 
 #endif
@@ -3,62 +3,187 @@
 #ifndef RINGQUEUE_H
 #define RINGQUEUE_H
 
-template<typename T, size_t SIZE>
+#include "../detail/RingIndex.h"
+#include "../detail/RingCopy.h"
+#include "../detail/RingQueueOverflow.h"
+
+template<typename T, size_t SIZE, typename size_type = size_t, typename Overflow = RingQueueOverflow::Overwrite>
 class RingQueue
 {
+    using Index = RingIndex::Fixed<SIZE, size_type>;
+    using index_type = typename Overflow::template index_type<size_type>;
+
 public:
 
-    inline size_t capacity() const { return SIZE; };
-    inline size_t size() const { return (tail_ - head_); };
+    inline size_type capacity() const { return SIZE; };
+    inline size_type size() const { return Index::distance(tail_, head_); };
     inline bool empty() const { return tail_ == head_; };
+    inline bool full() const { return size() == SIZE; };
     inline void clear() { head_ = 0; tail_ = 0; };
     inline void pop()
     {
-        if (size() == 0) return;
-        if (size() == 1) clear();
-        else head_++;
+        if (empty()) return;
+        head_ = Index::next(head_);
+    };
+    // push() follows the Overflow policy and returns false only if the element was not stored
+    inline bool push(T data)
+    {
+        if (!make_room(Overflow())) return false;
+        const size_type tail = tail_;
+        queue_[Index::slot(tail)] = data;
+        tail_ = Index::next(tail);
+        return true;
     };
-    inline void push(T data)
+    // never overwrites nor waits: false when full
+    inline bool try_push(T data)
     {
-        queue_[(tail_++) % SIZE] = data;
-        if      (size() > SIZE) head_++;
+        if (full()) return false;
+        const size_type tail = tail_;
+        queue_[Index::slot(tail)] = data;
+        tail_ = Index::next(tail);
+        return true;
     };
 
-    inline const T& front() const // throw(Exception)
+    // double-ended operations, O(1) at both ends
+    // push_front() overwrites the newest element when full with Overwrite and returns false with Reject
+    inline bool push_front(T data)
     {
-        // if(empty()) throw Exception();
-        return *(queue_ + head_ % SIZE);
+        if (!make_room_front(Overflow())) return false;
+        const size_type head = Index::prev(head_);
+        queue_[Index::slot(head)] = data;
+        head_ = head;
+        return true;
     };
-    inline T& front() // throw(Exception)
+    inline void pop_back()
     {
-        // if(empty()) throw Exception();
-        return *(queue_ + head_ % SIZE);
+        if (empty()) return;
+        tail_ = Index::prev(tail_);
     };
 
-    inline const T& back() const // throw(Exception)
+    // bulk operations copy in at most two contiguous segments
+    // push_n() follows the Overflow policy and returns the number of elements consumed from data
+    // - Overwrite : drops the oldest elements and keeps only the last SIZE if count exceeds the capacity
+    // - Reject    : stores as many as fit
+    // - Block     : waits until all are stored
+    inline size_type push_n(const T* data, const size_type count)
     {
-        // if(empty()) throw Exception();
-        return *(queue_ + (SIZE + tail_ - 1) % SIZE);
+        return push_n(data, count, Overflow());
     }
-    inline T& back() // throw(Exception)
+    inline size_type pop_n(T* data, const size_type count)
     {
-        // if(empty()) throw Exception();
-        return *(queue_ + (SIZE + tail_ - 1) % SIZE);
+        const size_type n = peek_n(data, count);
+        head_ = Index::advance(head_, n);
+        return n;
     }
+    inline size_type peek_n(T* data, size_type count) const
+    {
+        const size_type head = head_;
+        const size_type available = Index::distance(tail_, head);
+        if (count > available) count = available;
+        const size_type first = Index::slot(head);
+        const size_type contiguous = (SIZE - first < count) ? (SIZE - first) : count;
+        RingCopy::copy(data, queue_ + first, contiguous);
+        RingCopy::copy(data + contiguous, queue_, count - contiguous);
+        return count;
+    }
+
+    // unchecked accessors: the queue must not be empty (or index must be less than size())
+    inline const T& front() const { return queue_[Index::slot(head_)]; };
+    inline T& front() { return queue_[Index::slot(head_)]; };
+    inline const T& back() const { return queue_[Index::slot(Index::prev(tail_))]; };
+    inline T& back() { return queue_[Index::slot(Index::prev(tail_))]; };
+    inline const T& operator[] (uint8_t index) const { return queue_[Index::slot(head_, index)]; };
+    inline T& operator[] (uint8_t index) { return queue_[Index::slot(head_, index)]; };
+
+    // checked accessors: nullptr / false when the queue is empty
+    inline const T* front_ptr() const { return empty() ? nullptr : &front(); };
+    inline T* front_ptr() { return empty() ? nullptr : &front(); };
+    inline const T* back_ptr() const { return empty() ? nullptr : &back(); };
+    inline T* back_ptr() { return empty() ? nullptr : &back(); };
+    inline bool try_front(T& data) const
+    {
+        if (empty()) return false;
+        data = front();
+        return true;
+    };
+    inline bool try_back(T& data) const
+    {
+        if (empty()) return false;
+        data = back();
+        return true;
+    };
 
-    inline const T& operator[] (uint8_t index) const
+private:
+
+    inline bool make_room(RingQueueOverflow::Overwrite)
+    {
+        if (full()) head_ = Index::next(head_);
+        return true;
+    }
+    inline bool make_room(RingQueueOverflow::Reject)
     {
-        return *(queue_ + (head_ + index) % SIZE);
+        return !full();
     }
-    inline T& operator[] (uint8_t index)
+    inline bool make_room(RingQueueOverflow::Block)
     {
-        return *(queue_ + (head_ + index) % SIZE);
+        while (full()) Overflow::wait();
+        return true;
     }
 
-private:
+    // no Block overload: the front and back would no longer each have a single writer
+    inline bool make_room_front(RingQueueOverflow::Overwrite)
+    {
+        if (full()) tail_ = Index::prev(tail_);
+        return true;
+    }
+    inline bool make_room_front(RingQueueOverflow::Reject)
+    {
+        return !full();
+    }
+
+    // count must fit in the free space
+    inline void write_n(const T* data, const size_type count)
+    {
+        const size_type tail = tail_;
+        const size_type first = Index::slot(tail);
+        const size_type contiguous = (SIZE - first < count) ? (SIZE - first) : count;
+        RingCopy::copy(queue_ + first, data, contiguous);
+        RingCopy::copy(queue_, data + contiguous, count - contiguous);
+        tail_ = Index::advance(tail, count);
+    }
+
+    inline size_type push_n(const T* data, size_type count, RingQueueOverflow::Overwrite)
+    {
+        const size_type pushed = count;
+        if (count > SIZE) { data += count - SIZE; count = SIZE; }
+        const size_type space = SIZE - size();
+        if (count > space) head_ = Index::advance(head_, count - space);
+        write_n(data, count);
+        return pushed;
+    }
+    inline size_type push_n(const T* data, size_type count, RingQueueOverflow::Reject)
+    {
+        const size_type space = SIZE - size();
+        if (count > space) count = space;
+        write_n(data, count);
+        return count;
+    }
+    inline size_type push_n(const T* data, const size_type count, RingQueueOverflow::Block)
+    {
+        size_type pushed = 0;
+        while (pushed < count)
+        {
+            size_type n = SIZE - size();
+            if (n == 0) { Overflow::wait(); continue; }
+            if (n > count - pushed) n = count - pushed;
+            write_n(data + pushed, n);
+            pushed += n;
+        }
+        return pushed;
+    }
 
-    volatile size_t head_ {0};
-    volatile size_t tail_ {0};
+    index_type head_ {0};
+    index_type tail_ {0};
     T queue_[SIZE];
 };
 
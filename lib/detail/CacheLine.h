@@ -0,0 +1,22 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_CACHELINE_H
+#define EMBEDDEDUTILS_CACHELINE_H
+
+// alignment used to keep data written by different cores on separate cache lines
+// define EMBEDDEDUTILS_CACHELINE_SIZE before including to override
+
+#ifndef EMBEDDEDUTILS_CACHELINE_SIZE
+    #if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_8M_BASE__)
+        // Cortex-M0/M3/M23 have no data cache: do not waste RAM on padding
+        #define EMBEDDEDUTILS_CACHELINE_SIZE 4
+    #elif defined(ESP_PLATFORM) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+        #define EMBEDDEDUTILS_CACHELINE_SIZE 32
+    #elif defined(__APPLE__) && defined(__aarch64__)
+        #define EMBEDDEDUTILS_CACHELINE_SIZE 128
+    #else
+        #define EMBEDDEDUTILS_CACHELINE_SIZE 64
+    #endif
+#endif
+
+#endif // EMBEDDEDUTILS_CACHELINE_H
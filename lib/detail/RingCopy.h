@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RINGCOPY_H
+#define EMBEDDEDUTILS_RINGCOPY_H
+
+#include <stddef.h>
+#include <string.h>
+#ifndef __AVR__
+#include <new>
+#include <type_traits>
+#include <utility>
+#endif
+
+// element copy used by the bulk ring queue operations
+// trivially copyable types are moved with memcpy, others element by element
+// copy() assigns to live objects, construct() / destroy() manage objects in raw storage
+
+namespace RingCopy
+{
+#ifdef __AVR__
+    template <typename T>
+    struct is_trivially_copyable { static constexpr bool value = __is_trivially_copyable(T); };
+#else
+    template <typename T>
+    using is_trivially_copyable = std::is_trivially_copyable<T>;
+#endif
+
+    template <bool> struct Trivial {};
+
+    template <typename T>
+    inline void copy(T* dst, const T* src, const size_t n, Trivial<true>)
+    {
+        if (n) memcpy(dst, src, n * sizeof(T));
+    }
+
+    template <typename T>
+    inline void copy(T* dst, const T* src, const size_t n, Trivial<false>)
+    {
+        for (size_t i = 0; i < n; ++i) dst[i] = src[i];
+    }
+
+    template <typename T>
+    inline void copy(T* dst, const T* src, const size_t n)
+    {
+        copy(dst, src, n, Trivial<is_trivially_copyable<T>::value>());
+    }
+
+#ifndef __AVR__
+
+    template <typename T>
+    inline void construct(T* dst, const T* src, const size_t n, Trivial<true>)
+    {
+        if (n) memcpy((void*)dst, src, n * sizeof(T));
+    }
+
+    template <typename T>
+    inline void construct(T* dst, const T* src, const size_t n, Trivial<false>)
+    {
+        for (size_t i = 0; i < n; ++i) new (dst + i) T(src[i]);
+    }
+
+    template <typename T>
+    inline void construct(T* dst, const T* src, const size_t n)
+    {
+        construct(dst, src, n, Trivial<is_trivially_copyable<T>::value>());
+    }
+
+    // moves the elements out of src into live objects at dst and destroys them in src
+    template <typename T>
+    inline void relocate(T* dst, T* src, const size_t n, Trivial<true>)
+    {
+        if (n) memcpy(dst, src, n * sizeof(T));
+    }
+
+    template <typename T>
+    inline void relocate(T* dst, T* src, const size_t n, Trivial<false>)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            dst[i] = std::move(src[i]);
+            src[i].~T();
+        }
+    }
+
+    template <typename T>
+    inline void relocate(T* dst, T* src, const size_t n)
+    {
+        relocate(dst, src, n, Trivial<is_trivially_copyable<T>::value>());
+    }
+
+    template <typename T>
+    inline void destroy(T*, const size_t, Trivial<true>) {}
+
+    template <typename T>
+    inline void destroy(T* p, const size_t n, Trivial<false>)
+    {
+        for (size_t i = 0; i < n; ++i) p[i].~T();
+    }
+
+    template <typename T>
+    inline void destroy(T* p, const size_t n)
+    {
+        destroy(p, n, Trivial<std::is_trivially_destructible<T>::value>());
+    }
+
+#endif // __AVR__
+}
+
+#endif // EMBEDDEDUTILS_RINGCOPY_H
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RINGINDEX_H
+#define EMBEDDEDUTILS_RINGINDEX_H
+
+#include <stddef.h>
+
+// index arithmetic shared by the ring queues
+// - head / tail counters never need a modulo to be compared or advanced
+// - power-of-two sizes use free-running counters and a mask to find the slot
+// - other sizes run the counters over [0, 2 * SIZE) and find the slot with a compare and subtract,
+//   so wraparound of the counter type never breaks the ordering
+
+namespace RingIndex
+{
+    constexpr bool is_power_of_two(size_t n) { return (n != 0) && ((n & (n - 1)) == 0); }
+
+    // e.g. RingQueue<uint8_t, RingIndex::next_power_of_two(100)> to get masked indexing
+    constexpr size_t next_power_of_two(size_t n, size_t p = 1) { return (p >= n) ? p : next_power_of_two(n, p << 1); }
+
+    template <size_t SIZE, typename size_type, bool = is_power_of_two(SIZE)>
+    struct Fixed
+    {
+        static_assert(SIZE > 0, "ring size must be greater than 0");
+        static_assert(SIZE <= (size_type(~size_type(0)) >> 1), "ring size is too large for size_type");
+
+        static constexpr size_type RANGE = 2 * SIZE;
+
+        static inline size_type slot(const size_type i) { return (i < SIZE) ? i : (i - SIZE); }
+        static inline size_type slot(const size_type i, const size_type n)
+        {
+            const size_type s = slot(i) + n;
+            return (s < SIZE) ? s : (s - SIZE);
+        }
+        static inline size_type next(const size_type i) { return (i + 1 == RANGE) ? 0 : (i + 1); }
+        static inline size_type prev(const size_type i) { return (i == 0) ? (RANGE - 1) : (i - 1); }
+        static inline size_type advance(const size_type i, const size_type n)
+        {
+            return (n >= RANGE - i) ? (n - (RANGE - i)) : (i + n);
+        }
+        static inline size_type distance(const size_type tail, const size_type head)
+        {
+            return (tail >= head) ? (tail - head) : (tail + RANGE - head);
+        }
+        static inline bool valid(const size_type i) { return i < RANGE; }
+    };
+
+    template <size_t SIZE, typename size_type>
+    struct Fixed<SIZE, size_type, true>
+    {
+        static_assert(SIZE <= (size_type(~size_type(0)) >> 1), "ring size is too large for size_type");
+
+        static constexpr size_type MASK = SIZE - 1;
+
+        static inline size_type slot(const size_type i) { return i & MASK; }
+        static inline size_type slot(const size_type i, const size_type n) { return (size_type)(i + n) & MASK; }
+        static inline size_type next(const size_type i) { return i + 1; }
+        static inline size_type prev(const size_type i) { return i - 1; }
+        static inline size_type advance(const size_type i, const size_type n) { return i + n; }
+        static inline size_type distance(const size_type tail, const size_type head) { return tail - head; }
+        static inline bool valid(const size_type) { return true; }
+    };
+
+    // same as Fixed for a ring whose size is only known at runtime (counters over [0, 2 * size))
+    // not a template, so every runtime-sized queue shares this code
+    class Dynamic
+    {
+    public:
+        explicit Dynamic(const size_t size) : size_(size), range_(2 * size) {}
+
+        inline size_t size() const { return size_; }
+
+        inline size_t slot(const size_t i) const { return (i < size_) ? i : (i - size_); }
+        inline size_t slot(const size_t i, const size_t n) const
+        {
+            const size_t s = slot(i) + n;
+            return (s < size_) ? s : (s - size_);
+        }
+        inline size_t next(const size_t i) const { return (i + 1 == range_) ? 0 : (i + 1); }
+        inline size_t prev(const size_t i) const { return (i == 0) ? (range_ - 1) : (i - 1); }
+        inline size_t advance(const size_t i, const size_t n) const
+        {
+            return (n >= range_ - i) ? (n - (range_ - i)) : (i + n);
+        }
+        inline size_t distance(const size_t tail, const size_t head) const
+        {
+            return (tail >= head) ? (tail - head) : (tail + range_ - head);
+        }
+        inline bool valid(const size_t i) const { return i < range_; }
+
+    private:
+        size_t size_;
+        size_t range_;
+    };
+}
+
+#endif // EMBEDDEDUTILS_RINGINDEX_H
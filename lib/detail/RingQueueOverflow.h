@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RINGQUEUEOVERFLOW_H
+#define EMBEDDEDUTILS_RINGQUEUEOVERFLOW_H
+
+#ifndef __AVR__
+#include <atomic>
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32) || defined(ESP_PLATFORM)
+#include <chrono>
+#include <thread>
+#define EMBEDDEDUTILS_RINGQUEUE_HAS_THREAD
+#endif
+#endif
+
+// what RingQueue::push() does when the queue is full
+// - Overwrite : drop the oldest element (default, previous behaviour)
+// - Reject    : leave the queue as is and return false
+// - Block     : wait until the consumer (ISR or another thread) makes room
+// try_push() never overwrites nor waits with any policy
+
+namespace RingQueueOverflow
+{
+    struct Overwrite
+    {
+        template <typename size_type> using index_type = volatile size_type;
+    };
+
+    struct Reject
+    {
+        template <typename size_type> using index_type = volatile size_type;
+    };
+
+    struct Block
+    {
+#ifdef __AVR__
+        template <typename size_type> using index_type = volatile size_type;
+#else
+        // the consumer runs concurrently on a host, so the indices have to be atomic to publish the slots
+        template <typename size_type> using index_type = std::atomic<size_type>;
+#endif
+        static inline void wait()
+        {
+#ifdef EMBEDDEDUTILS_RINGQUEUE_HAS_THREAD
+            std::this_thread::yield();
+#endif
+        }
+    };
+}
+
+#endif // EMBEDDEDUTILS_RINGQUEUEOVERFLOW_H
@@ -0,0 +1,75 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RINGQUEUESTATS_H
+#define EMBEDDEDUTILS_RINGQUEUESTATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// opt-in instrumentation for RingQueue, selected by its Stats template parameter
+// - None       : every hook is empty and the policy takes no storage (default)
+// - Counters   : pushes / pops / overwrites / drops and the high-watermark
+// - Histogram  : Counters plus occupancy sampled after every push, in BINS equal-width bins
+// the producer writes pushes / overwrites / drops / high_watermark / bins and the consumer writes pops,
+// so each field has a single writer even when the queue is shared with an ISR or another thread
+
+namespace RingQueueStats
+{
+    struct None
+    {
+        static constexpr bool ENABLED = false;
+        inline void on_push(const size_t, const size_t, const size_t) {}
+        inline void on_pop(const size_t) {}
+        inline void on_overwrite(const size_t) {}
+        inline void on_drop(const size_t) {}
+    };
+
+    template <typename counter_type = uint32_t>
+    struct Counters
+    {
+        static constexpr bool ENABLED = true;
+
+        counter_type pushes {0};
+        counter_type pops {0};
+        counter_type overwrites {0};
+        counter_type drops {0};
+        size_t high_watermark {0};
+
+        // count elements were stored and size is the occupancy afterwards
+        inline void on_push(const size_t count, const size_t size, const size_t)
+        {
+            pushes += (counter_type)count;
+            if (size > high_watermark) high_watermark = size;
+        }
+        inline void on_pop(const size_t count) { pops += (counter_type)count; }
+        // elements lost from the queue (or from a bulk push) to make room
+        inline void on_overwrite(const size_t count) { overwrites += (counter_type)count; }
+        // elements refused because the queue was full
+        inline void on_drop(const size_t count) { drops += (counter_type)count; }
+
+        inline void reset() { pushes = pops = overwrites = drops = 0; high_watermark = 0; }
+    };
+
+    template <size_t BINS, typename counter_type = uint32_t>
+    struct Histogram : public Counters<counter_type>
+    {
+        static_assert(BINS > 0, "Histogram needs at least one bin");
+
+        // bins[i] counts pushes after which the occupancy was in [i, i + 1) * (capacity + 1) / BINS
+        counter_type bins[BINS] {};
+
+        inline void on_push(const size_t count, const size_t size, const size_t capacity)
+        {
+            Counters<counter_type>::on_push(count, size, capacity);
+            ++bins[size * BINS / (capacity + 1)];
+        }
+
+        inline void reset()
+        {
+            Counters<counter_type>::reset();
+            for (size_t i = 0; i < BINS; ++i) bins[i] = 0;
+        }
+    };
+}
+
+#endif // EMBEDDEDUTILS_RINGQUEUESTATS_H
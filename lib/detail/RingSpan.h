@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_RINGSPAN_H
+#define EMBEDDEDUTILS_RINGSPAN_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// contiguous (pointer, length) view into ring storage
+
+template <typename T, typename size_type = size_t>
+struct RingSpan
+{
+    T* data;
+    size_type size;
+
+    inline bool empty() const { return size == 0; }
+    inline T* begin() const { return data; }
+    inline T* end() const { return data + size; }
+    inline T& operator[] (const size_type index) const { return data[index]; }
+};
+
+// readable contents of a ring as at most two contiguous views, in queue order
+template <typename T, typename size_type = size_t>
+struct RingSpans
+{
+    RingSpan<T, size_type> first;
+    RingSpan<T, size_type> second;
+
+    inline size_type size() const { return first.size + second.size; }
+    inline bool empty() const { return first.size == 0; }
+};
+
+// forward iterator over ring storage
+// wraps from the end of the buffer to its start with a pointer compare instead of index arithmetic
+template <typename T, typename size_type = size_t>
+class RingIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::remove_const<T>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    RingIterator() : ptr_(nullptr), base_(nullptr), limit_(nullptr), remaining_(0) {}
+    RingIterator(T* ptr, T* base, const size_type capacity, const size_type remaining)
+    : ptr_(ptr), base_(base), limit_(base + capacity), remaining_(remaining) {}
+
+    inline reference operator* () const { return *ptr_; }
+    inline pointer operator-> () const { return ptr_; }
+
+    inline RingIterator& operator++ ()
+    {
+        if (++ptr_ == limit_) ptr_ = base_;
+        --remaining_;
+        return *this;
+    }
+    inline RingIterator operator++ (int)
+    {
+        RingIterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    // iterators of the same ring compare by the number of elements left
+    inline bool operator== (const RingIterator& it) const { return remaining_ == it.remaining_; }
+    inline bool operator!= (const RingIterator& it) const { return remaining_ != it.remaining_; }
+
+private:
+    T* ptr_;
+    T* base_;
+    T* limit_;
+    size_type remaining_;
+};
+
+#endif // EMBEDDEDUTILS_RINGSPAN_H
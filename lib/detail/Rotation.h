@@ -0,0 +1,430 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_ROTATION_H
+#define EMBEDDEDUTILS_ROTATION_H
+
+#ifndef __AVR__
+#include <cstddef>
+#include <cmath>
+#endif
+
+#include "Macro.h"
+#include "Vec2f.h"
+#include "Vec3f.h"
+
+// precomputed rotations: the trigonometry of Vec2f::rotate() / Vec3f::rotate() is done once
+// when the rotation is built, and every apply() is then a few multiply-adds
+// - angles are in degrees like the Vec rotate() methods, the ...Rad() factories take radians
+// - Rotation2f and Rotation3f use the same formulas as the matching Vec methods,
+//   so apply() gives the same result as getRotated() with the same arguments
+// - Euler angles follow Vec3f::rotate(ax, ay, az): R = Rx(ax) * Ry(ay) * Rz(az)
+
+class Quatf;
+
+/// \brief A 2D rotation stored as its cosine / sine pair.
+///
+/// ~~~~{.cpp}
+/// Rotation2f r(45);      // same as Vec2f::rotate(45)
+/// Vec2f v = r.apply(Vec2f(1, 0));
+/// r.apply(points, points, n); // rotate n points in place
+/// ~~~~
+class Rotation2f {
+public:
+	/// \brief Cosine of the angle.
+	float c;
+	/// \brief Sine of the angle.
+	float s;
+
+	/// \brief The identity rotation.
+	Rotation2f();
+
+	/// \brief Rotation by `angle` degrees.
+	explicit Rotation2f( float angle );
+
+	/// \brief Rotation by `angle` radians.
+	static Rotation2f fromRad( float angle );
+
+	/// \brief The rotation applied to `vec`, like `vec.getRotated(angle)`.
+	Vec2f apply( const Vec2f& vec ) const;
+
+	/// \brief The rotation applied around `pivot`, like `vec.getRotated(angle, pivot)`.
+	Vec2f apply( const Vec2f& vec, const Vec2f& pivot ) const;
+
+	/// \brief Rotate `n` vectors from `in` to `out`; `in` and `out` may be the same buffer.
+	void apply( const Vec2f* in, Vec2f* out, size_t n ) const;
+
+	/// \brief The rotation by the opposite angle.
+	Rotation2f getInverse() const;
+
+	/// \brief `this` after `r`: (a * b).apply(v) is a.apply(b.apply(v)).
+	Rotation2f operator*( const Rotation2f& r ) const;
+
+	float angle() const;
+	float angleRad() const;
+
+private:
+	Rotation2f( float c, float s );
+};
+
+
+/// \brief A 3D rotation stored as a 3x3 matrix.
+///
+/// ~~~~{.cpp}
+/// Rotation3f r(30, Vec3f(0, 0, 1));   // same as Vec3f::rotate(30, axis)
+/// Rotation3f e = Rotation3f::fromEuler(10, 20, 30); // same as Vec3f::rotate(10, 20, 30)
+/// e.apply(mesh, mesh, n);
+/// ~~~~
+/// \sa Quatf
+class Rotation3f {
+public:
+	/// \brief Row major: `apply(v).x` is `m[0][0]*v.x + m[0][1]*v.y + m[0][2]*v.z`.
+	float m[3][3];
+
+	/// \brief The identity rotation.
+	Rotation3f();
+
+	/// \brief Rotation by `angle` degrees around `axis` (need not be normalized).
+	Rotation3f( float angle, const Vec3f& axis );
+
+	/// \brief Same rotation as the quaternion `q` (need not be normalized).
+	explicit Rotation3f( const Quatf& q );
+
+	/// \brief Rotation by `angle` radians around `axis`.
+	static Rotation3f fromRad( float angle, const Vec3f& axis );
+
+	/// \brief Rotation by Euler angles in degrees, like `rotate(ax, ay, az)`.
+	static Rotation3f fromEuler( float ax, float ay, float az );
+
+	/// \brief Rotation by Euler angles in radians, like `rotateRad(ax, ay, az)`.
+	static Rotation3f fromEulerRad( float ax, float ay, float az );
+
+	/// \brief The rotation applied to `vec`.
+	Vec3f apply( const Vec3f& vec ) const;
+
+	/// \brief The rotation applied around `pivot`, like `vec.getRotated(angle, pivot, axis)`.
+	Vec3f apply( const Vec3f& vec, const Vec3f& pivot ) const;
+
+	/// \brief Rotate `n` vectors from `in` to `out`; `in` and `out` may be the same buffer.
+	void apply( const Vec3f* in, Vec3f* out, size_t n ) const;
+
+	/// \brief The opposite rotation (the transposed matrix).
+	Rotation3f getInverse() const;
+
+	/// \brief `this` after `r`: (a * b).apply(v) is a.apply(b.apply(v)).
+	Rotation3f operator*( const Rotation3f& r ) const;
+
+private:
+	static Rotation3f fromEulerCosSin( float a, float b, float c, float d, float e, float f );
+};
+
+
+/// \brief A 3D rotation stored as a unit quaternion `w + xi + yj + zk`.
+///
+/// Cheaper to compose and to renormalize than a matrix, e.g. to integrate gyro rates;
+/// convert to Rotation3f to rotate many vectors.
+///
+/// ~~~~{.cpp}
+/// Quatf q = Quatf::fromEuler(10, 20, 30);
+/// q = q * Quatf(1, Vec3f(0, 0, 1));   // then 1 degree around z first
+/// q.normalize();
+/// Vec3f v = q.apply(Vec3f(1, 0, 0));
+/// ~~~~
+/// \sa Rotation3f
+class Quatf {
+public:
+	float w;
+	float x;
+	float y;
+	float z;
+
+	/// \brief The identity rotation.
+	Quatf();
+
+	/// \brief A quaternion with the given components.
+	Quatf( float w, float x, float y, float z );
+
+	/// \brief Rotation by `angle` degrees around `axis` (need not be normalized).
+	Quatf( float angle, const Vec3f& axis );
+
+	/// \brief Rotation by `angle` radians around `axis`.
+	static Quatf fromRad( float angle, const Vec3f& axis );
+
+	/// \brief Rotation by Euler angles in degrees, like `Vec3f::rotate(ax, ay, az)`.
+	static Quatf fromEuler( float ax, float ay, float az );
+
+	/// \brief Rotation by Euler angles in radians, like `Vec3f::rotateRad(ax, ay, az)`.
+	static Quatf fromEulerRad( float ax, float ay, float az );
+
+	/// \brief The rotation applied to `vec`; the quaternion must be normalized.
+	Vec3f apply( const Vec3f& vec ) const;
+
+	/// \brief Rotate `n` vectors from `in` to `out` through the equivalent Rotation3f;
+	/// `in` and `out` may be the same buffer.
+	void apply( const Vec3f* in, Vec3f* out, size_t n ) const;
+
+	float length() const;
+	Quatf getNormalized() const;
+	Quatf& normalize();
+
+	/// \brief The conjugate, which is the opposite rotation for a normalized quaternion.
+	Quatf getInverse() const;
+
+	/// \brief Hamilton product, `this` after `q`: (a * b).apply(v) is a.apply(b.apply(v)).
+	Quatf operator*( const Quatf& q ) const;
+
+	float dot( const Quatf& q ) const;
+};
+
+
+
+
+/// \cond INTERNAL
+
+// Rotation2f
+//
+//
+inline Rotation2f::Rotation2f(): c(1), s(0) {}
+inline Rotation2f::Rotation2f( float _c, float _s ): c(_c), s(_s) {}
+
+inline Rotation2f::Rotation2f( float angle ) {
+	float a = (float)(angle*DEG_TO_RAD);
+	c = cos(a);
+	s = sin(a);
+}
+
+inline Rotation2f Rotation2f::fromRad( float angle ) {
+	return Rotation2f( cos(angle), sin(angle) );
+}
+
+inline Vec2f Rotation2f::apply( const Vec2f& vec ) const {
+	return Vec2f( vec.x*c - vec.y*s,
+				  vec.x*s + vec.y*c );
+}
+
+inline Vec2f Rotation2f::apply( const Vec2f& vec, const Vec2f& pivot ) const {
+	return Vec2f( ((vec.x-pivot.x)*c - (vec.y-pivot.y)*s) + pivot.x,
+				  ((vec.x-pivot.x)*s + (vec.y-pivot.y)*c) + pivot.y );
+}
+
+inline void Rotation2f::apply( const Vec2f* in, Vec2f* out, size_t n ) const {
+	for( size_t i = 0; i < n; ++i ) {
+		const float vx = in[i].x;
+		const float vy = in[i].y;
+		out[i].x = vx*c - vy*s;
+		out[i].y = vx*s + vy*c;
+	}
+}
+
+inline Rotation2f Rotation2f::getInverse() const {
+	return Rotation2f( c, -s );
+}
+
+inline Rotation2f Rotation2f::operator*( const Rotation2f& r ) const {
+	return Rotation2f( c*r.c - s*r.s, s*r.c + c*r.s );
+}
+
+inline float Rotation2f::angle() const {
+	return (float)(atan2(s, c)*RAD_TO_DEG);
+}
+
+inline float Rotation2f::angleRad() const {
+	return atan2(s, c);
+}
+
+
+// Rotation3f
+//
+//
+inline Rotation3f::Rotation3f() {
+	for( int i = 0; i < 3; ++i ) {
+		for( int j = 0; j < 3; ++j ) m[i][j] = (i == j) ? 1.0f : 0.0f;
+	}
+}
+
+inline Rotation3f::Rotation3f( float angle, const Vec3f& axis ) {
+	*this = fromRad( (float)(angle*DEG_TO_RAD), axis );
+}
+
+inline Rotation3f Rotation3f::fromRad( float angle, const Vec3f& axis ) {
+	Vec3f ax = axis.getNormalized();
+	float sina = sin( angle );
+	float cosa = cos( angle );
+	float cosb = 1.0f - cosa;
+
+	Rotation3f r;
+	r.m[0][0] = ax.x*ax.x*cosb + cosa;
+	r.m[0][1] = ax.x*ax.y*cosb - ax.z*sina;
+	r.m[0][2] = ax.x*ax.z*cosb + ax.y*sina;
+	r.m[1][0] = ax.y*ax.x*cosb + ax.z*sina;
+	r.m[1][1] = ax.y*ax.y*cosb + cosa;
+	r.m[1][2] = ax.y*ax.z*cosb - ax.x*sina;
+	r.m[2][0] = ax.z*ax.x*cosb - ax.y*sina;
+	r.m[2][1] = ax.z*ax.y*cosb + ax.x*sina;
+	r.m[2][2] = ax.z*ax.z*cosb + cosa;
+	return r;
+}
+
+// a, b: cos / sin of ax; c, d: of ay; e, f: of az (see Vec3f::getRotated(ax, ay, az))
+inline Rotation3f Rotation3f::fromEulerCosSin( float a, float b, float c, float d, float e, float f ) {
+	Rotation3f r;
+	r.m[0][0] = c * e;
+	r.m[0][1] = -(c * f);
+	r.m[0][2] = d;
+	r.m[1][0] = a * f + b * d * e;
+	r.m[1][1] = a * e - b * d * f;
+	r.m[1][2] = -(b * c);
+	r.m[2][0] = b * f - a * d * e;
+	r.m[2][1] = a * d * f + b * e;
+	r.m[2][2] = a * c;
+	return r;
+}
+
+inline Rotation3f Rotation3f::fromEuler( float ax, float ay, float az ) {
+	return fromEulerCosSin( (float)cos(DEG_TO_RAD*(ax)), (float)sin(DEG_TO_RAD*(ax)),
+							(float)cos(DEG_TO_RAD*(ay)), (float)sin(DEG_TO_RAD*(ay)),
+							(float)cos(DEG_TO_RAD*(az)), (float)sin(DEG_TO_RAD*(az)) );
+}
+
+inline Rotation3f Rotation3f::fromEulerRad( float ax, float ay, float az ) {
+	return fromEulerCosSin( cos(ax), sin(ax), cos(ay), sin(ay), cos(az), sin(az) );
+}
+
+inline Rotation3f::Rotation3f( const Quatf& quat ) {
+	Quatf q = quat.getNormalized();
+	float xx = q.x*q.x, yy = q.y*q.y, zz = q.z*q.z;
+	float xy = q.x*q.y, xz = q.x*q.z, yz = q.y*q.z;
+	float wx = q.w*q.x, wy = q.w*q.y, wz = q.w*q.z;
+
+	m[0][0] = 1.0f - 2.0f*(yy + zz);
+	m[0][1] = 2.0f*(xy - wz);
+	m[0][2] = 2.0f*(xz + wy);
+	m[1][0] = 2.0f*(xy + wz);
+	m[1][1] = 1.0f - 2.0f*(xx + zz);
+	m[1][2] = 2.0f*(yz - wx);
+	m[2][0] = 2.0f*(xz - wy);
+	m[2][1] = 2.0f*(yz + wx);
+	m[2][2] = 1.0f - 2.0f*(xx + yy);
+}
+
+inline Vec3f Rotation3f::apply( const Vec3f& vec ) const {
+	return Vec3f( vec.x*m[0][0] + vec.y*m[0][1] + vec.z*m[0][2],
+				  vec.x*m[1][0] + vec.y*m[1][1] + vec.z*m[1][2],
+				  vec.x*m[2][0] + vec.y*m[2][1] + vec.z*m[2][2] );
+}
+
+inline Vec3f Rotation3f::apply( const Vec3f& vec, const Vec3f& pivot ) const {
+	return apply( vec - pivot ) + pivot;
+}
+
+inline void Rotation3f::apply( const Vec3f* in, Vec3f* out, size_t n ) const {
+	// the matrix is copied to locals, so the compiler need not reload it after each store through out
+	const float m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+	const float m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+	const float m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+	for( size_t i = 0; i < n; ++i ) {
+		const float vx = in[i].x;
+		const float vy = in[i].y;
+		const float vz = in[i].z;
+		out[i].x = vx*m00 + vy*m01 + vz*m02;
+		out[i].y = vx*m10 + vy*m11 + vz*m12;
+		out[i].z = vx*m20 + vy*m21 + vz*m22;
+	}
+}
+
+inline Rotation3f Rotation3f::getInverse() const {
+	Rotation3f r;
+	for( int i = 0; i < 3; ++i ) {
+		for( int j = 0; j < 3; ++j ) r.m[i][j] = m[j][i];
+	}
+	return r;
+}
+
+inline Rotation3f Rotation3f::operator*( const Rotation3f& r ) const {
+	Rotation3f p;
+	for( int i = 0; i < 3; ++i ) {
+		for( int j = 0; j < 3; ++j ) p.m[i][j] = m[i][0]*r.m[0][j] + m[i][1]*r.m[1][j] + m[i][2]*r.m[2][j];
+	}
+	return p;
+}
+
+
+// Quatf
+//
+//
+inline Quatf::Quatf(): w(1), x(0), y(0), z(0) {}
+inline Quatf::Quatf( float _w, float _x, float _y, float _z ): w(_w), x(_x), y(_y), z(_z) {}
+
+inline Quatf::Quatf( float angle, const Vec3f& axis ) {
+	*this = fromRad( (float)(angle*DEG_TO_RAD), axis );
+}
+
+inline Quatf Quatf::fromRad( float angle, const Vec3f& axis ) {
+	Vec3f ax = axis.getNormalized();
+	float h = 0.5f*angle;
+	float s = sin( h );
+	return Quatf( cos( h ), ax.x*s, ax.y*s, ax.z*s );
+}
+
+inline Quatf Quatf::fromEuler( float ax, float ay, float az ) {
+	return fromEulerRad( (float)(ax*DEG_TO_RAD), (float)(ay*DEG_TO_RAD), (float)(az*DEG_TO_RAD) );
+}
+
+inline Quatf Quatf::fromEulerRad( float ax, float ay, float az ) {
+	// qx * qy * qz, expanded
+	float cx = cos(0.5f*ax), sx = sin(0.5f*ax);
+	float cy = cos(0.5f*ay), sy = sin(0.5f*ay);
+	float cz = cos(0.5f*az), sz = sin(0.5f*az);
+	return Quatf( cx*cy*cz - sx*sy*sz,
+				  sx*cy*cz + cx*sy*sz,
+				  cx*sy*cz - sx*cy*sz,
+				  cx*cy*sz + sx*sy*cz );
+}
+
+inline Vec3f Quatf::apply( const Vec3f& vec ) const {
+	// v + w*t + u x t with u = (x, y, z) and t = 2 u x v
+	Vec3f u( x, y, z );
+	Vec3f t = u.getCrossed(vec) * 2.0f;
+	return vec + t*w + u.getCrossed(t);
+}
+
+inline void Quatf::apply( const Vec3f* in, Vec3f* out, size_t n ) const {
+	Rotation3f( *this ).apply( in, out, n );
+}
+
+inline float Quatf::length() const {
+	return (float)sqrt( w*w + x*x + y*y + z*z );
+}
+
+inline Quatf Quatf::getNormalized() const {
+	return Quatf( *this ).normalize();
+}
+
+inline Quatf& Quatf::normalize() {
+	const VecPrecision::Length length( w*w + x*x + y*y + z*z );
+	if( length.positive() ) {
+		w /= length;
+		x /= length;
+		y /= length;
+		z /= length;
+	}
+	return *this;
+}
+
+inline Quatf Quatf::getInverse() const {
+	return Quatf( w, -x, -y, -z );
+}
+
+inline Quatf Quatf::operator*( const Quatf& q ) const {
+	return Quatf( w*q.w - x*q.x - y*q.y - z*q.z,
+				  w*q.x + x*q.w + y*q.z - z*q.y,
+				  w*q.y - x*q.z + y*q.w + z*q.x,
+				  w*q.z + x*q.y - y*q.x + z*q.w );
+}
+
+inline float Quatf::dot( const Quatf& q ) const {
+	return w*q.w + x*q.x + y*q.y + z*q.z;
+}
+
+/// \endcond
+
+#endif // EMBEDDEDUTILS_ROTATION_H
@@ -0,0 +1,296 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_SIMD_H
+#define EMBEDDEDUTILS_SIMD_H
+
+// 4 x float vector operations used by Vec4f and Vec3fA
+// - SSE on x86, NEON on Cortex-A / AArch64, Helium (MVE) on Cortex-M55 / M85, plain floats otherwise (AVR)
+// - every load / store is unaligned, so the vectors keep their float[4] layout and alignment
+// - Simd::Wide is the widest vector of the target for the SoA batch kernels (VecArray.h):
+//   8 floats when the compiler targets AVX (-mavx / -mavx2 / -march=native), f32x4 otherwise
+// - define EMBEDDEDUTILS_NO_SIMD to force the scalar path
+
+#if !defined(EMBEDDEDUTILS_NO_SIMD) && !defined(__AVR__)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define EMBEDDEDUTILS_SIMD_SSE
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define EMBEDDEDUTILS_SIMD_AVX
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define EMBEDDEDUTILS_SIMD_NEON
+#include <arm_neon.h>
+#elif defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#define EMBEDDEDUTILS_SIMD_HELIUM
+#include <arm_mve.h>
+#endif
+#endif
+
+#include <math.h>
+
+namespace Simd
+{
+#if defined(EMBEDDEDUTILS_SIMD_SSE)
+
+    typedef __m128 f32x4;
+
+    inline f32x4 load(const float* p) { return _mm_loadu_ps(p); }
+    inline void store(float* p, const f32x4 v) { _mm_storeu_ps(p, v); }
+    inline f32x4 set1(const float f) { return _mm_set1_ps(f); }
+    inline f32x4 set(const float x, const float y, const float z, const float w) { return _mm_setr_ps(x, y, z, w); }
+
+    inline f32x4 add(const f32x4 a, const f32x4 b) { return _mm_add_ps(a, b); }
+    inline f32x4 sub(const f32x4 a, const f32x4 b) { return _mm_sub_ps(a, b); }
+    inline f32x4 mul(const f32x4 a, const f32x4 b) { return _mm_mul_ps(a, b); }
+    inline f32x4 div(const f32x4 a, const f32x4 b) { return _mm_div_ps(a, b); }
+    inline f32x4 neg(const f32x4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+    inline f32x4 sqrt(const f32x4 a) { return _mm_sqrt_ps(a); }
+
+    // a / b where b is non-zero, a where it is zero
+    inline f32x4 div_nonzero(const f32x4 a, const f32x4 b)
+    {
+        const f32x4 nz = _mm_cmpneq_ps(b, _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(nz, _mm_div_ps(a, b)), _mm_andnot_ps(nz, a));
+    }
+
+    // a where c > 0, +0 elsewhere (including NaN)
+    inline f32x4 select_positive(const f32x4 c, const f32x4 a) { return _mm_and_ps(_mm_cmpgt_ps(c, _mm_setzero_ps()), a); }
+
+    inline float hsum(const f32x4 v)
+    {
+        const f32x4 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    }
+
+    // (y, z, x, w)
+    inline f32x4 yzx(const f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+    inline f32x4 zero_w(const f32x4 v)
+    {
+        return _mm_and_ps(v, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+    }
+
+#elif defined(EMBEDDEDUTILS_SIMD_NEON)
+
+    typedef float32x4_t f32x4;
+
+    inline f32x4 load(const float* p) { return vld1q_f32(p); }
+    inline void store(float* p, const f32x4 v) { vst1q_f32(p, v); }
+    inline f32x4 set1(const float f) { return vdupq_n_f32(f); }
+    inline f32x4 set(const float x, const float y, const float z, const float w)
+    {
+        const float p[4] = { x, y, z, w };
+        return vld1q_f32(p);
+    }
+
+    inline f32x4 add(const f32x4 a, const f32x4 b) { return vaddq_f32(a, b); }
+    inline f32x4 sub(const f32x4 a, const f32x4 b) { return vsubq_f32(a, b); }
+    inline f32x4 mul(const f32x4 a, const f32x4 b) { return vmulq_f32(a, b); }
+    inline f32x4 neg(const f32x4 a) { return vnegq_f32(a); }
+#if defined(__aarch64__)
+    inline f32x4 div(const f32x4 a, const f32x4 b) { return vdivq_f32(a, b); }
+    inline f32x4 sqrt(const f32x4 a) { return vsqrtq_f32(a); }
+#else
+    // ARMv7 NEON has only reciprocal (square root) estimates, so work per lane to keep the results exact
+    inline f32x4 div(const f32x4 a, const f32x4 b)
+    {
+        float pa[4], pb[4];
+        vst1q_f32(pa, a);
+        vst1q_f32(pb, b);
+        for (int i = 0; i < 4; ++i) pa[i] /= pb[i];
+        return vld1q_f32(pa);
+    }
+    inline f32x4 sqrt(const f32x4 a)
+    {
+        float pa[4];
+        vst1q_f32(pa, a);
+        for (int i = 0; i < 4; ++i) pa[i] = sqrtf(pa[i]);
+        return vld1q_f32(pa);
+    }
+#endif
+
+    inline f32x4 div_nonzero(const f32x4 a, const f32x4 b)
+    {
+        const uint32x4_t nz = vmvnq_u32(vceqq_f32(b, vdupq_n_f32(0.0f)));
+        return vbslq_f32(nz, div(a, b), a);
+    }
+
+    inline f32x4 select_positive(const f32x4 c, const f32x4 a)
+    {
+        return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(c, vdupq_n_f32(0.0f)), vreinterpretq_u32_f32(a)));
+    }
+
+    inline float hsum(const f32x4 v)
+    {
+#if defined(__aarch64__)
+        return vaddvq_f32(v);
+#else
+        const float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+    }
+
+    // (y, z, x, w)
+    inline f32x4 yzx(const f32x4 v)
+    {
+        const float32x2_t lo = vget_low_f32(v);
+        const float32x2_t hi = vget_high_f32(v);
+        return vcombine_f32(vext_f32(lo, hi, 1), vrev64_f32(vext_f32(hi, lo, 1)));
+    }
+    inline f32x4 zero_w(const f32x4 v) { return vsetq_lane_f32(0.0f, v, 3); }
+
+#elif defined(EMBEDDEDUTILS_SIMD_HELIUM)
+
+    typedef float32x4_t f32x4;
+
+    inline f32x4 load(const float* p) { return vld1q_f32(p); }
+    inline void store(float* p, const f32x4 v) { vst1q_f32(p, v); }
+    inline f32x4 set1(const float f) { return vdupq_n_f32(f); }
+    inline f32x4 set(const float x, const float y, const float z, const float w)
+    {
+        const float p[4] = { x, y, z, w };
+        return vld1q_f32(p);
+    }
+
+    inline f32x4 add(const f32x4 a, const f32x4 b) { return vaddq_f32(a, b); }
+    inline f32x4 sub(const f32x4 a, const f32x4 b) { return vsubq_f32(a, b); }
+    inline f32x4 mul(const f32x4 a, const f32x4 b) { return vmulq_f32(a, b); }
+    inline f32x4 neg(const f32x4 a) { return vnegq_f32(a); }
+    // MVE has no vector divide or square root
+    inline f32x4 div(const f32x4 a, const f32x4 b)
+    {
+        float pa[4], pb[4];
+        vst1q_f32(pa, a);
+        vst1q_f32(pb, b);
+        for (int i = 0; i < 4; ++i) pa[i] /= pb[i];
+        return vld1q_f32(pa);
+    }
+    inline f32x4 sqrt(const f32x4 a)
+    {
+        float pa[4];
+        vst1q_f32(pa, a);
+        for (int i = 0; i < 4; ++i) pa[i] = sqrtf(pa[i]);
+        return vld1q_f32(pa);
+    }
+
+    inline f32x4 div_nonzero(const f32x4 a, const f32x4 b)
+    {
+        return vpselq_f32(div(a, b), a, vcmpneq_n_f32(b, 0.0f));
+    }
+
+    inline f32x4 select_positive(const f32x4 c, const f32x4 a)
+    {
+        return vpselq_f32(a, vdupq_n_f32(0.0f), vcmpgtq_n_f32(c, 0.0f));
+    }
+
+    inline float hsum(const f32x4 v)
+    {
+        return (vgetq_lane_f32(v, 0) + vgetq_lane_f32(v, 1)) + (vgetq_lane_f32(v, 2) + vgetq_lane_f32(v, 3));
+    }
+
+    // (y, z, x, w); MVE has no cross-lane float shuffle
+    inline f32x4 yzx(const f32x4 v)
+    {
+        return set(vgetq_lane_f32(v, 1), vgetq_lane_f32(v, 2), vgetq_lane_f32(v, 0), vgetq_lane_f32(v, 3));
+    }
+    inline f32x4 zero_w(const f32x4 v) { return vsetq_lane_f32(0.0f, v, 3); }
+
+#else
+
+    struct f32x4
+    {
+        float v[4];
+    };
+
+    inline f32x4 load(const float* p) { return f32x4 { { p[0], p[1], p[2], p[3] } }; }
+    inline void store(float* p, const f32x4 a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+    inline f32x4 set1(const float f) { return f32x4 { { f, f, f, f } }; }
+    inline f32x4 set(const float x, const float y, const float z, const float w) { return f32x4 { { x, y, z, w } }; }
+
+    inline f32x4 add(const f32x4 a, const f32x4 b) { return f32x4 { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+    inline f32x4 sub(const f32x4 a, const f32x4 b) { return f32x4 { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+    inline f32x4 mul(const f32x4 a, const f32x4 b) { return f32x4 { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+    inline f32x4 div(const f32x4 a, const f32x4 b) { return f32x4 { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; }
+    inline f32x4 neg(const f32x4 a) { return f32x4 { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; }
+    inline f32x4 sqrt(const f32x4 a) { return f32x4 { { sqrtf(a.v[0]), sqrtf(a.v[1]), sqrtf(a.v[2]), sqrtf(a.v[3]) } }; }
+
+    inline f32x4 div_nonzero(const f32x4 a, const f32x4 b)
+    {
+        return f32x4 { {
+            (b.v[0] != 0) ? a.v[0] / b.v[0] : a.v[0],
+            (b.v[1] != 0) ? a.v[1] / b.v[1] : a.v[1],
+            (b.v[2] != 0) ? a.v[2] / b.v[2] : a.v[2],
+            (b.v[3] != 0) ? a.v[3] / b.v[3] : a.v[3] } };
+    }
+
+    inline f32x4 select_positive(const f32x4 c, const f32x4 a)
+    {
+        return f32x4 { {
+            (c.v[0] > 0) ? a.v[0] : 0.0f,
+            (c.v[1] > 0) ? a.v[1] : 0.0f,
+            (c.v[2] > 0) ? a.v[2] : 0.0f,
+            (c.v[3] > 0) ? a.v[3] : 0.0f } };
+    }
+
+    // same order as x + y + z + w
+    inline float hsum(const f32x4 a) { return a.v[0] + a.v[1] + a.v[2] + a.v[3]; }
+
+    inline f32x4 yzx(const f32x4 a) { return f32x4 { { a.v[1], a.v[2], a.v[0], a.v[3] } }; }
+    inline f32x4 zero_w(const f32x4 a) { return f32x4 { { a.v[0], a.v[1], a.v[2], 0.0f } }; }
+
+#endif
+
+    // cross product of the xyz parts with two shuffles; w is (a.w * b.w - a.w * b.w)
+    inline f32x4 cross3(const f32x4 a, const f32x4 b)
+    {
+        return yzx(sub(mul(a, yzx(b)), mul(yzx(a), b)));
+    }
+
+    namespace Wide
+    {
+#if defined(EMBEDDEDUTILS_SIMD_AVX)
+
+        typedef __m256 f32xN;
+        static constexpr int WIDTH = 8;
+
+        inline f32xN load(const float* p) { return _mm256_loadu_ps(p); }
+        inline void store(float* p, const f32xN v) { _mm256_storeu_ps(p, v); }
+        inline f32xN set1(const float f) { return _mm256_set1_ps(f); }
+
+        inline f32xN add(const f32xN a, const f32xN b) { return _mm256_add_ps(a, b); }
+        inline f32xN sub(const f32xN a, const f32xN b) { return _mm256_sub_ps(a, b); }
+        inline f32xN mul(const f32xN a, const f32xN b) { return _mm256_mul_ps(a, b); }
+        inline f32xN div(const f32xN a, const f32xN b) { return _mm256_div_ps(a, b); }
+        inline f32xN sqrt(const f32xN a) { return _mm256_sqrt_ps(a); }
+
+        inline f32xN div_nonzero(const f32xN a, const f32xN b)
+        {
+            return _mm256_blendv_ps(a, _mm256_div_ps(a, b), _mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+        }
+
+        inline f32xN select_positive(const f32xN c, const f32xN a)
+        {
+            return _mm256_and_ps(_mm256_cmp_ps(c, _mm256_setzero_ps(), _CMP_GT_OQ), a);
+        }
+
+#else
+
+        typedef f32x4 f32xN;
+        static constexpr int WIDTH = 4;
+
+        using Simd::load;
+        using Simd::store;
+        using Simd::set1;
+        using Simd::add;
+        using Simd::sub;
+        using Simd::mul;
+        using Simd::div;
+        using Simd::sqrt;
+        using Simd::div_nonzero;
+        using Simd::select_positive;
+
+#endif
+    }
+}
+
+#endif // EMBEDDEDUTILS_SIMD_H
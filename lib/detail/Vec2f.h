@@ -6,6 +6,7 @@
 #endif
 
 #include "Macro.h"
+#include "VecPrecision.h"
 
 class Vec3f;
 class Vec4f;
@@ -1175,8 +1176,8 @@ inline Vec2f& Vec2f::operator/=( const float f ) {
 // }
 
 inline Vec2f Vec2f::getScaled( const float length ) const {
-	float l = sqrt(x*x + y*y);
-	if( l > 0 )
+	const VecPrecision::Length l(x*x + y*y);
+	if( l.positive() )
 		return Vec2f( (x/l)*length, (y/l)*length );
 	else
 		return Vec2f();
@@ -1187,8 +1188,8 @@ inline Vec2f Vec2f::getScaled( const float length ) const {
 // }
 
 inline Vec2f& Vec2f::scale( const float length ) {
-	float l = sqrt(x*x + y*y);
-	if (l > 0) {
+	const VecPrecision::Length l(x*x + y*y);
+	if( l.positive() ) {
 		x = (x/l)*length;
 		y = (y/l)*length;
 	}
@@ -1389,8 +1390,8 @@ inline Vec2f& Vec2f::average( const Vec2f* points, size_t num ) {
 // }
 
 inline Vec2f Vec2f::getNormalized() const {
-	float length = sqrt(x*x + y*y);
-	if( length > 0 ) {
+	const VecPrecision::Length length(x*x + y*y);
+	if( length.positive() ) {
 		return Vec2f( x/length, y/length );
 	} else {
 		return Vec2f();
@@ -1398,8 +1399,8 @@ inline Vec2f Vec2f::getNormalized() const {
 }
 
 inline Vec2f& Vec2f::normalize() {
-	float length = sqrt(x*x + y*y);
-	if( length > 0 ) {
+	const VecPrecision::Length length(x*x + y*y);
+	if( length.positive() ) {
 		x /= length;
 		y /= length;
 	}
@@ -1419,7 +1420,7 @@ inline Vec2f Vec2f::getLimited(float max) const {
     Vec2f limited;
     float lengthSquared = (x*x + y*y);
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
+        float ratio = max/VecPrecision::Length(lengthSquared);
         limited.set( x*ratio, y*ratio);
     } else {
         limited.set(x,y);
@@ -1430,7 +1431,7 @@ inline Vec2f Vec2f::getLimited(float max) const {
 inline Vec2f& Vec2f::limit(float max) {
     float lengthSquared = (x*x + y*y);
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
+        float ratio = max/VecPrecision::Length(lengthSquared);
         x *= ratio;
         y *= ratio;
     }
@@ -1447,16 +1448,16 @@ inline Vec2f& Vec2f::limit(float max) {
 // }
 
 inline Vec2f Vec2f::getPerpendicular() const {
-	float length = sqrt( x*x + y*y );
-	if( length > 0 )
+	const VecPrecision::Length length(x*x + y*y);
+	if( length.positive() )
 		return Vec2f( -(y/length), x/length );
 	else
 		return Vec2f();
 }
 
 inline Vec2f& Vec2f::perpendicular() {
-	float length = sqrt( x*x + y*y );
-	if( length > 0 ) {
+	const VecPrecision::Length length(x*x + y*y);
+	if( length.positive() ) {
 		float _x = x;
 		x = -(y/length);
 		y = _x/length;
@@ -6,6 +6,7 @@
 #endif
 
 #include "Macro.h"
+#include "VecPrecision.h"
 
 class Vec2f;
 class Vec4f;
@@ -1268,8 +1269,8 @@ inline Vec3f& Vec3f::operator/=( const float f ) {
 // 	return getScaled(length);
 // }
 inline Vec3f Vec3f::getScaled( const float length ) const {
-	float l = sqrt(x*x + y*y + z*z);
-	if( l > 0 )
+	const VecPrecision::Length l(x*x + y*y + z*z);
+	if( l.positive() )
 		return Vec3f( (x/l)*length, (y/l)*length, (z/l)*length );
 	else
 		return Vec3f();
@@ -1278,8 +1279,8 @@ inline Vec3f Vec3f::getScaled( const float length ) const {
 // 	return scale(length);
 // }
 inline Vec3f& Vec3f::scale( const float length ) {
-	float l = sqrt(x*x + y*y + z*z);
-	if (l > 0) {
+	const VecPrecision::Length l(x*x + y*y + z*z);
+	if( l.positive() ) {
 		x = (x/l)*length;
 		y = (y/l)*length;
 		z = (z/l)*length;
@@ -1700,8 +1701,8 @@ inline Vec3f& Vec3f::average( const Vec3f* points, int num ) {
 // }
 
 inline Vec3f Vec3f::getNormalized() const {
-	float length = sqrt(x*x + y*y + z*z);
-	if( length > 0 ) {
+	const VecPrecision::Length length(x*x + y*y + z*z);
+	if( length.positive() ) {
 		return Vec3f( x/length, y/length, z/length );
 	} else {
 		return Vec3f();
@@ -1709,8 +1710,8 @@ inline Vec3f Vec3f::getNormalized() const {
 }
 
 inline Vec3f& Vec3f::normalize() {
-	float length = sqrt(x*x + y*y + z*z);
-	if( length > 0 ) {
+	const VecPrecision::Length length(x*x + y*y + z*z);
+	if( length.positive() ) {
 		x /= length;
 		y /= length;
 		z /= length;
@@ -1732,7 +1733,7 @@ inline Vec3f Vec3f::getLimited(float max) const {
     Vec3f limited;
     float lengthSquared = (x*x + y*y + z*z);
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
+        float ratio = max/VecPrecision::Length(lengthSquared);
         limited.set( x*ratio, y*ratio, z*ratio);
     } else {
         limited.set(x,y,z);
@@ -1743,7 +1744,7 @@ inline Vec3f Vec3f::getLimited(float max) const {
 inline Vec3f& Vec3f::limit(float max) {
     float lengthSquared = (x*x + y*y + z*z);
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
+        float ratio = max/VecPrecision::Length(lengthSquared);
         x *= ratio;
         y *= ratio;
         z *= ratio;
@@ -1785,11 +1786,11 @@ inline Vec3f Vec3f::getPerpendicular( const Vec3f& vec ) const {
 	float crossY = z*vec.x - x*vec.z;
 	float crossZ = x*vec.y - y*vec.x;
 
-	float length = sqrt(crossX*crossX +
-							 crossY*crossY +
-							 crossZ*crossZ);
+	const VecPrecision::Length length(crossX*crossX +
+									  crossY*crossY +
+									  crossZ*crossZ);
 
-	if( length > 0 )
+	if( length.positive() )
 		return Vec3f( crossX/length, crossY/length, crossZ/length );
 	else
 		return Vec3f();
@@ -1800,11 +1801,11 @@ inline Vec3f& Vec3f::perpendicular( const Vec3f& vec ) {
 	float crossY = z*vec.x - x*vec.z;
 	float crossZ = x*vec.y - y*vec.x;
 
-	float length = sqrt(crossX*crossX +
-							 crossY*crossY +
-							 crossZ*crossZ);
+	const VecPrecision::Length length(crossX*crossX +
+									  crossY*crossY +
+									  crossZ*crossZ);
 
-	if( length > 0 ) {
+	if( length.positive() ) {
 		x = crossX/length;
 		y = crossY/length;
 		z = crossZ/length;
@@ -0,0 +1,609 @@
+#pragma once
+
+#ifndef __AVR__
+#include <cstddef>
+#include <cmath>
+#endif
+
+#include "Macro.h"
+#include "Simd.h"
+#include "VecPrecision.h"
+#include "Vec3f.h"
+
+/// \brief Vec3fA is a Vec3f padded to 16 bytes and aligned to 16 bytes.
+///
+/// The fourth component 'w' is always 0, so the vector fills exactly one SIMD
+/// register (see Simd.h) and every arithmetic operation, dot product, length and
+/// cross product is a handful of vector instructions instead of three scalar ones.
+/// Use it for hot arrays in physics / IMU code; it converts implicitly to and from Vec3f.
+///
+/// ~~~~{.cpp}
+/// Vec3fA a(1, 0, 0), b(0, 1, 0);
+/// Vec3fA c = a.getCrossed(b); // (0, 0, 1)
+/// Vec3f v = c;                // back to the 12 byte layout
+/// ~~~~
+/// \sa Vec3f
+class alignas(16) Vec3fA {
+public:
+	/// \cond INTERNAL
+	static constexpr int DIM = 3;
+	/// \endcond
+
+	union {
+		float data[4];
+		struct {
+			float x;
+			float y;
+			float z;
+			/// \brief Padding, kept at 0.
+			float w;
+		};
+	};
+
+	//---------------------
+	/// \name Construct a 3D vector
+	/// \{
+
+	Vec3fA();
+	Vec3fA( float x, float y, float z=0.0f );
+	explicit Vec3fA( float scalar );
+	Vec3fA( const Vec3f& vec );
+
+	/// \brief Convert to the 12 byte Vec3f.
+	operator Vec3f() const { return Vec3f(x, y, z); }
+
+	/// \}
+
+	//---------------------
+	/// \name Access components
+	/// \{
+
+	float * getPtr() { return data; }
+	const float * getPtr() const { return data; }
+
+	float& operator[]( size_t n ) { return data[n]; }
+	float operator[]( size_t n ) const { return data[n]; }
+
+	void set( float x, float y, float z = 0 );
+	void set( const Vec3fA& vec );
+	void set( float _scalar );
+
+	/// \}
+
+	//---------------------
+	/// \name Comparison
+	/// \{
+
+	bool operator==( const Vec3fA& vec ) const;
+	bool operator!=( const Vec3fA& vec ) const;
+	bool match( const Vec3fA& vec, float tolerance = 0.0001f ) const;
+	bool isAligned( const Vec3fA& vec, float tolerance = 0.0001f ) const;
+	bool isAlignedRad( const Vec3fA& vec, float tolerance = 0.0001f ) const;
+
+	/// \}
+
+	//---------------------
+	/// \name Operators
+	/// \{
+
+	Vec3fA  operator+( const Vec3fA& pnt ) const;
+	Vec3fA  operator+( const float f ) const;
+	Vec3fA& operator+=( const Vec3fA& pnt );
+	Vec3fA& operator+=( const float f );
+	Vec3fA  operator-( const Vec3fA& vec ) const;
+	Vec3fA  operator-( const float f ) const;
+	Vec3fA  operator-() const;
+	Vec3fA& operator-=( const Vec3fA& vec );
+	Vec3fA& operator-=( const float f );
+	Vec3fA  operator*( const Vec3fA& vec ) const;
+	Vec3fA  operator*( const float f ) const;
+	Vec3fA& operator*=( const Vec3fA& vec );
+	Vec3fA& operator*=( const float f );
+	/// \brief Components divided by zero are left as they are, like Vec3f.
+	Vec3fA  operator/( const Vec3fA& vec ) const;
+	Vec3fA  operator/( const float f ) const;
+	Vec3fA& operator/=( const Vec3fA& vec );
+	Vec3fA& operator/=( const float f );
+
+	/// \}
+
+	//---------------------
+	/// \name Simple manipulations
+	/// \{
+
+	Vec3fA  getScaled( const float length ) const;
+	Vec3fA& scale( const float length );
+
+	/// \brief Rotations are computed through Vec3f; see Vec3f::getRotated().
+	Vec3fA  getRotated( float angle, const Vec3fA& axis ) const;
+	Vec3fA  getRotated( float ax, float ay, float az ) const;
+	Vec3fA  getRotated( float angle, const Vec3fA& pivot, const Vec3fA& axis ) const;
+	Vec3fA  getRotatedRad( float angle, const Vec3fA& axis ) const;
+	Vec3fA  getRotatedRad( float ax, float ay, float az ) const;
+	Vec3fA  getRotatedRad( float angle, const Vec3fA& pivot, const Vec3fA& axis ) const;
+	Vec3fA& rotate( float angle, const Vec3fA& axis );
+	Vec3fA& rotate( float ax, float ay, float az );
+	Vec3fA& rotate( float angle, const Vec3fA& pivot, const Vec3fA& axis );
+	Vec3fA& rotateRad( float angle, const Vec3fA& axis );
+	Vec3fA& rotateRad( float ax, float ay, float az );
+	Vec3fA& rotateRad( float angle, const Vec3fA& pivot, const Vec3fA& axis );
+
+	Vec3fA  getMapped( const Vec3fA& origin, const Vec3fA& vx, const Vec3fA& vy, const Vec3fA& vz ) const;
+	Vec3fA& map( const Vec3fA& origin, const Vec3fA& vx, const Vec3fA& vy, const Vec3fA& vz );
+
+	/// \}
+
+	//---------------------
+	/// \name Distance
+	/// \{
+
+	float distance( const Vec3fA& pnt ) const;
+	float squareDistance( const Vec3fA& pnt ) const;
+
+	/// \}
+
+	//---------------------
+	/// \name Interpolation
+	/// \{
+
+	Vec3fA  getInterpolated( const Vec3fA& pnt, float p ) const;
+	Vec3fA& interpolate( const Vec3fA& pnt, float p );
+	Vec3fA  getMiddle( const Vec3fA& pnt ) const;
+	Vec3fA& middle( const Vec3fA& pnt );
+	Vec3fA& average( const Vec3fA* points, int num );
+
+	/// \}
+
+	//---------------------
+	/// \name Limit
+	/// \{
+
+	Vec3fA  getNormalized() const;
+	Vec3fA& normalize();
+	Vec3fA  getLimited( float max ) const;
+	Vec3fA& limit( float max );
+
+	/// \}
+
+	//---------------------
+	/// \name Measurement
+	/// \{
+
+	float length() const;
+	float lengthSquared() const;
+	float angle( const Vec3fA& vec ) const;
+	float angleRad( const Vec3fA& vec ) const;
+
+	/// \}
+
+	//---------------------
+	/// \name Perpendicular
+	/// \{
+
+	Vec3fA  getPerpendicular( const Vec3fA& vec ) const;
+	Vec3fA& perpendicular( const Vec3fA& vec );
+	/// \brief Cross product with two shuffles per operand.
+	Vec3fA  getCrossed( const Vec3fA& vec ) const;
+	Vec3fA& cross( const Vec3fA& vec );
+	float dot( const Vec3fA& vec ) const;
+
+	/// \}
+
+	/// \cond INTERNAL
+
+	static Vec3fA zero() { return Vec3fA(0, 0, 0); }
+	static Vec3fA one() { return Vec3fA(1, 1, 1); }
+
+	// the components as one SIMD register, w = 0
+	Simd::f32x4 simd() const { return Simd::load(data); }
+	static Vec3fA fromSimd( const Simd::f32x4 v ) { Vec3fA r; Simd::store(r.data, v); return r; }
+
+	// f in x, y and z and 0 in w, so adding / multiplying keeps w at 0
+	static Simd::f32x4 splat( const float f ) { return Simd::set(f, f, f, 0.0f); }
+	// f in x, y and z and 1 in w, so dividing keeps w at 0
+	static Simd::f32x4 divisor( const float f ) { return Simd::set(f, f, f, 1.0f); }
+
+	/// \endcond
+};
+
+
+/// \cond INTERNAL
+
+
+// Non-Member operators
+//
+//
+Vec3fA operator+( float f, const Vec3fA& vec );
+Vec3fA operator-( float f, const Vec3fA& vec );
+Vec3fA operator*( float f, const Vec3fA& vec );
+Vec3fA operator/( float f, const Vec3fA& vec );
+
+
+/////////////////
+// Implementation
+/////////////////
+
+
+inline Vec3fA::Vec3fA(): x(0), y(0), z(0), w(0) {}
+inline Vec3fA::Vec3fA( float _all ): x(_all), y(_all), z(_all), w(0) {}
+inline Vec3fA::Vec3fA( float _x, float _y, float _z ): x(_x), y(_y), z(_z), w(0) {}
+inline Vec3fA::Vec3fA( const Vec3f& vec ): x(vec.x), y(vec.y), z(vec.z), w(0) {}
+
+
+// Getters and Setters.
+//
+//
+inline void Vec3fA::set( float _scalar ) {
+	x = _scalar;
+	y = _scalar;
+	z = _scalar;
+}
+
+inline void Vec3fA::set( float _x, float _y, float _z ) {
+	x = _x;
+	y = _y;
+	z = _z;
+}
+
+inline void Vec3fA::set( const Vec3fA& vec ) {
+	Simd::store(data, vec.simd());
+}
+
+
+// Check similarity/equality.
+//
+//
+inline bool Vec3fA::operator==( const Vec3fA& vec ) const {
+	return (x == vec.x) && (y == vec.y) && (z == vec.z);
+}
+
+inline bool Vec3fA::operator!=( const Vec3fA& vec ) const {
+	return (x != vec.x) || (y != vec.y) || (z != vec.z);
+}
+
+inline bool Vec3fA::match( const Vec3fA& vec, float tolerance ) const {
+	return (fabs(x - vec.x) < tolerance)
+	&& (fabs(y - vec.y) < tolerance)
+	&& (fabs(z - vec.z) < tolerance);
+}
+
+inline bool Vec3fA::isAligned( const Vec3fA& vec, float tolerance ) const {
+	return angle( vec ) < tolerance;
+}
+
+inline bool Vec3fA::isAlignedRad( const Vec3fA& vec, float tolerance ) const {
+	return angleRad( vec ) < tolerance;
+}
+
+
+// Additions and Subtractions.
+//
+//
+inline Vec3fA Vec3fA::operator+( const Vec3fA& pnt ) const {
+	return fromSimd( Simd::add(simd(), pnt.simd()) );
+}
+
+inline Vec3fA& Vec3fA::operator+=( const Vec3fA& pnt ) {
+	Simd::store(data, Simd::add(simd(), pnt.simd()));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator-( const Vec3fA& vec ) const {
+	return fromSimd( Simd::sub(simd(), vec.simd()) );
+}
+
+inline Vec3fA& Vec3fA::operator-=( const Vec3fA& vec ) {
+	Simd::store(data, Simd::sub(simd(), vec.simd()));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator+( const float f ) const {
+	return fromSimd( Simd::add(simd(), splat(f)) );
+}
+
+inline Vec3fA& Vec3fA::operator+=( const float f ) {
+	Simd::store(data, Simd::add(simd(), splat(f)));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator-( const float f ) const {
+	return fromSimd( Simd::sub(simd(), splat(f)) );
+}
+
+inline Vec3fA& Vec3fA::operator-=( const float f ) {
+	Simd::store(data, Simd::sub(simd(), splat(f)));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator-() const {
+	return fromSimd( Simd::zero_w(Simd::neg(simd())) );
+}
+
+
+// Scalings
+//
+//
+inline Vec3fA Vec3fA::operator*( const Vec3fA& vec ) const {
+	return fromSimd( Simd::mul(simd(), vec.simd()) );
+}
+
+inline Vec3fA& Vec3fA::operator*=( const Vec3fA& vec ) {
+	Simd::store(data, Simd::mul(simd(), vec.simd()));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator*( const float f ) const {
+	return fromSimd( Simd::mul(simd(), splat(f)) );
+}
+
+inline Vec3fA& Vec3fA::operator*=( const float f ) {
+	Simd::store(data, Simd::mul(simd(), splat(f)));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator/( const Vec3fA& vec ) const {
+	return fromSimd( Simd::div_nonzero(simd(), vec.simd()) );
+}
+
+inline Vec3fA& Vec3fA::operator/=( const Vec3fA& vec ) {
+	Simd::store(data, Simd::div_nonzero(simd(), vec.simd()));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::operator/( const float f ) const {
+	if(f == 0) return *this;
+
+	return fromSimd( Simd::div(simd(), divisor(f)) );
+}
+
+inline Vec3fA& Vec3fA::operator/=( const float f ) {
+	if(f == 0) return *this;
+
+	Simd::store(data, Simd::div(simd(), divisor(f)));
+	return *this;
+}
+
+
+// Scaling
+//
+//
+inline Vec3fA Vec3fA::getScaled( const float length ) const {
+	const VecPrecision::Length l(lengthSquared());
+	if( l.positive() )
+		return fromSimd( Simd::mul(l.divide(simd()), splat(length)) );
+	else
+		return Vec3fA();
+}
+
+inline Vec3fA& Vec3fA::scale( const float length ) {
+	const VecPrecision::Length l(lengthSquared());
+	if( l.positive() ) {
+		Simd::store(data, Simd::mul(l.divide(simd()), splat(length)));
+	}
+	return *this;
+}
+
+
+// Rotation
+//
+//
+inline Vec3fA Vec3fA::getRotated( float angle, const Vec3fA& axis ) const {
+	return Vec3f(*this).getRotated(angle, Vec3f(axis));
+}
+
+inline Vec3fA Vec3fA::getRotated( float ax, float ay, float az ) const {
+	return Vec3f(*this).getRotated(ax, ay, az);
+}
+
+inline Vec3fA Vec3fA::getRotated( float angle, const Vec3fA& pivot, const Vec3fA& axis ) const {
+	return Vec3f(*this).getRotated(angle, Vec3f(pivot), Vec3f(axis));
+}
+
+inline Vec3fA Vec3fA::getRotatedRad( float angle, const Vec3fA& axis ) const {
+	return Vec3f(*this).getRotatedRad(angle, Vec3f(axis));
+}
+
+inline Vec3fA Vec3fA::getRotatedRad( float ax, float ay, float az ) const {
+	return Vec3f(*this).getRotatedRad(ax, ay, az);
+}
+
+inline Vec3fA Vec3fA::getRotatedRad( float angle, const Vec3fA& pivot, const Vec3fA& axis ) const {
+	return Vec3f(*this).getRotatedRad(angle, Vec3f(pivot), Vec3f(axis));
+}
+
+inline Vec3fA& Vec3fA::rotate( float angle, const Vec3fA& axis ) {
+	return *this = getRotated(angle, axis);
+}
+
+inline Vec3fA& Vec3fA::rotate( float ax, float ay, float az ) {
+	return *this = getRotated(ax, ay, az);
+}
+
+inline Vec3fA& Vec3fA::rotate( float angle, const Vec3fA& pivot, const Vec3fA& axis ) {
+	return *this = getRotated(angle, pivot, axis);
+}
+
+inline Vec3fA& Vec3fA::rotateRad( float angle, const Vec3fA& axis ) {
+	return *this = getRotatedRad(angle, axis);
+}
+
+inline Vec3fA& Vec3fA::rotateRad( float ax, float ay, float az ) {
+	return *this = getRotatedRad(ax, ay, az);
+}
+
+inline Vec3fA& Vec3fA::rotateRad( float angle, const Vec3fA& pivot, const Vec3fA& axis ) {
+	return *this = getRotatedRad(angle, pivot, axis);
+}
+
+
+// Map point to coordinate system defined by origin, vx, vy, and vz.
+//
+//
+inline Vec3fA Vec3fA::getMapped( const Vec3fA& origin, const Vec3fA& vx, const Vec3fA& vy, const Vec3fA& vz ) const {
+	Simd::f32x4 v = Simd::add(origin.simd(), Simd::mul(vx.simd(), Simd::set1(x)));
+	v = Simd::add(v, Simd::mul(vy.simd(), Simd::set1(y)));
+	return fromSimd( Simd::add(v, Simd::mul(vz.simd(), Simd::set1(z))) );
+}
+
+inline Vec3fA& Vec3fA::map( const Vec3fA& origin, const Vec3fA& vx, const Vec3fA& vy, const Vec3fA& vz ) {
+	return *this = getMapped(origin, vx, vy, vz);
+}
+
+
+// Distance between two points.
+//
+//
+inline float Vec3fA::distance( const Vec3fA& pnt ) const {
+	return sqrt(squareDistance(pnt));
+}
+
+inline float Vec3fA::squareDistance( const Vec3fA& pnt ) const {
+	const Simd::f32x4 v = Simd::sub(simd(), pnt.simd());
+	return Simd::hsum(Simd::mul(v, v));
+}
+
+
+// Linear interpolation.
+//
+//
+inline Vec3fA Vec3fA::getInterpolated( const Vec3fA& pnt, float p ) const {
+	return fromSimd( Simd::add(Simd::mul(simd(), splat(1-p)), Simd::mul(pnt.simd(), splat(p))) );
+}
+
+inline Vec3fA& Vec3fA::interpolate( const Vec3fA& pnt, float p ) {
+	Simd::store(data, Simd::add(Simd::mul(simd(), splat(1-p)), Simd::mul(pnt.simd(), splat(p))));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::getMiddle( const Vec3fA& pnt ) const {
+	return fromSimd( Simd::div(Simd::add(simd(), pnt.simd()), Simd::set1(2.0f)) );
+}
+
+inline Vec3fA& Vec3fA::middle( const Vec3fA& pnt ) {
+	Simd::store(data, Simd::div(Simd::add(simd(), pnt.simd()), Simd::set1(2.0f)));
+	return *this;
+}
+
+
+// Average (centroid) among points.
+//
+//
+inline Vec3fA& Vec3fA::average( const Vec3fA* points, int num ) {
+	Simd::f32x4 sum = Simd::set1(0.f);
+	for( int i=0; i<num; i++) {
+		sum = Simd::add(sum, points[i].simd());
+	}
+	Simd::store(data, Simd::div(sum, divisor((float)num)));
+	return *this;
+}
+
+
+// Normalization
+//
+//
+inline Vec3fA Vec3fA::getNormalized() const {
+	const VecPrecision::Length length(lengthSquared());
+	if( length.positive() ) {
+		return fromSimd( length.divide(simd()) );
+	} else {
+		return Vec3fA();
+	}
+}
+
+inline Vec3fA& Vec3fA::normalize() {
+	const VecPrecision::Length length(lengthSquared());
+	if( length.positive() ) {
+		Simd::store(data, length.divide(simd()));
+	}
+	return *this;
+}
+
+
+// Limit length.
+//
+//
+inline Vec3fA Vec3fA::getLimited( float max ) const {
+	float lengthSquared = this->lengthSquared();
+	if( lengthSquared > max*max && lengthSquared > 0 ) {
+		float ratio = max/VecPrecision::Length(lengthSquared);
+		return fromSimd( Simd::mul(simd(), splat(ratio)) );
+	}
+	return *this;
+}
+
+inline Vec3fA& Vec3fA::limit( float max ) {
+	float lengthSquared = this->lengthSquared();
+	if( lengthSquared > max*max && lengthSquared > 0 ) {
+		float ratio = max/VecPrecision::Length(lengthSquared);
+		Simd::store(data, Simd::mul(simd(), splat(ratio)));
+	}
+	return *this;
+}
+
+
+// Perpendicular vector.
+//
+//
+inline Vec3fA Vec3fA::getCrossed( const Vec3fA& vec ) const {
+	return fromSimd( Simd::cross3(simd(), vec.simd()) );
+}
+
+inline Vec3fA& Vec3fA::cross( const Vec3fA& vec ) {
+	Simd::store(data, Simd::cross3(simd(), vec.simd()));
+	return *this;
+}
+
+inline Vec3fA Vec3fA::getPerpendicular( const Vec3fA& vec ) const {
+	return getCrossed(vec).getNormalized();
+}
+
+inline Vec3fA& Vec3fA::perpendicular( const Vec3fA& vec ) {
+	return *this = getPerpendicular(vec);
+}
+
+
+// Length
+//
+//
+inline float Vec3fA::length() const {
+	return sqrt(lengthSquared());
+}
+
+inline float Vec3fA::lengthSquared() const {
+	const Simd::f32x4 v = simd();
+	return Simd::hsum(Simd::mul(v, v));
+}
+
+inline float Vec3fA::angle( const Vec3fA& vec ) const {
+	return acos( getNormalized().dot(vec.getNormalized()) )*RAD_TO_DEG;
+}
+
+inline float Vec3fA::angleRad( const Vec3fA& vec ) const {
+	return acos( getNormalized().dot(vec.getNormalized()) );
+}
+
+inline float Vec3fA::dot( const Vec3fA& vec ) const {
+	return Simd::hsum(Simd::mul(simd(), vec.simd()));
+}
+
+
+// Non-Member operators
+//
+//
+inline Vec3fA operator+( float f, const Vec3fA& vec ) {
+	return Vec3fA::fromSimd( Simd::add(Vec3fA::splat(f), vec.simd()) );
+}
+
+inline Vec3fA operator-( float f, const Vec3fA& vec ) {
+	return Vec3fA::fromSimd( Simd::sub(Vec3fA::splat(f), vec.simd()) );
+}
+
+inline Vec3fA operator*( float f, const Vec3fA& vec ) {
+	return Vec3fA::fromSimd( Simd::mul(Vec3fA::splat(f), vec.simd()) );
+}
+
+inline Vec3fA operator/( float f, const Vec3fA& vec ) {
+	return Vec3fA::fromSimd( Simd::zero_w(Simd::div(Vec3fA::splat(f), vec.simd())) );
+}
+
+/// \endcond
@@ -6,6 +6,8 @@
 #endif
 
 #include "Macro.h"
+#include "Simd.h"
+#include "VecPrecision.h"
 
 class Vec2f;
 class Vec3f;
@@ -275,6 +277,10 @@ public:
 
     // return all one vector
     static Vec4f one() { return Vec4f(1, 1, 1, 1); }
+
+    // the components as one SIMD register (see Simd.h), loaded and stored unaligned
+    Simd::f32x4 simd() const { return Simd::load(data); }
+    static Vec4f fromSimd( const Simd::f32x4 v ) { Vec4f r; Simd::store(r.data, v); return r; }
     /// \endcond
 };
 
@@ -357,55 +363,43 @@ inline bool Vec4f::match( const Vec4f& vec, float tolerance) const {
 //
 //
 inline Vec4f Vec4f::operator+( const Vec4f& vec ) const {
-	return Vec4f( x+vec.x, y+vec.y, z+vec.z, w+vec.w);
+	return fromSimd( Simd::add(simd(), vec.simd()) );
 }
 
 inline Vec4f& Vec4f::operator+=( const Vec4f& vec ) {
-	x += vec.x;
-	y += vec.y;
-	z += vec.z;
-	w += vec.w;
+	Simd::store(data, Simd::add(simd(), vec.simd()));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator-( const float f ) const {
-	return Vec4f( x-f, y-f, z-f, w-f );
+	return fromSimd( Simd::sub(simd(), Simd::set1(f)) );
 }
 
 inline Vec4f& Vec4f::operator-=( const float f ) {
-	x -= f;
-	y -= f;
-	z -= f;
-	w -= f;
+	Simd::store(data, Simd::sub(simd(), Simd::set1(f)));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator-( const Vec4f& vec ) const {
-	return Vec4f( x-vec.x, y-vec.y, z-vec.z, w-vec.w );
+	return fromSimd( Simd::sub(simd(), vec.simd()) );
 }
 
 inline Vec4f& Vec4f::operator-=( const Vec4f& vec ) {
-	x -= vec.x;
-	y -= vec.y;
-	z -= vec.z;
-	w -= vec.w;
+	Simd::store(data, Simd::sub(simd(), vec.simd()));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator+( const float f ) const {
-	return Vec4f( x+f, y+f, z+f, w+f );
+	return fromSimd( Simd::add(simd(), Simd::set1(f)) );
 }
 
 inline Vec4f& Vec4f::operator+=( const float f ) {
-	x += f;
-	y += f;
-	z += f;
-	w += f;
+	Simd::store(data, Simd::add(simd(), Simd::set1(f)));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator-() const {
-	return Vec4f( -x, -y, -z, -w );
+	return fromSimd( Simd::neg(simd()) );
 }
 
 
@@ -413,54 +407,43 @@ inline Vec4f Vec4f::operator-() const {
 //
 //
 inline Vec4f Vec4f::operator*( const Vec4f& vec ) const {
-	return Vec4f( x*vec.x, y*vec.y, z*vec.z, w*vec.w );
+	return fromSimd( Simd::mul(simd(), vec.simd()) );
 }
 
 inline Vec4f& Vec4f::operator*=( const Vec4f& vec ) {
-	x *= vec.x;
-	y *= vec.y;
-	z *= vec.z;
-	w *= vec.w;
+	Simd::store(data, Simd::mul(simd(), vec.simd()));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator*( const float f ) const {
-	return Vec4f( x*f, y*f, z*f, w*f );
+	return fromSimd( Simd::mul(simd(), Simd::set1(f)) );
 }
 
 inline Vec4f& Vec4f::operator*=( const float f ) {
-	x *= f;
-	y *= f;
-	z *= f;
-	w *= f;
+	Simd::store(data, Simd::mul(simd(), Simd::set1(f)));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator/( const Vec4f& vec ) const {
-	return Vec4f( vec.x!=0 ? x/vec.x : x , vec.y!=0 ? y/vec.y : y, vec.z!=0 ? z/vec.z : z, vec.w!=0 ? w/vec.w : w  );
+	// components divided by zero are left as they are
+	return fromSimd( Simd::div_nonzero(simd(), vec.simd()) );
 }
 
 inline Vec4f& Vec4f::operator/=( const Vec4f& vec ) {
-	vec.x!=0 ? x/=vec.x : x;
-	vec.y!=0 ? y/=vec.y : y;
-	vec.z!=0 ? z/=vec.z : z;
-	vec.w!=0 ? w/=vec.w : w;
+	Simd::store(data, Simd::div_nonzero(simd(), vec.simd()));
 	return *this;
 }
 
 inline Vec4f Vec4f::operator/( const float f ) const {
 	if(f == 0) return Vec4f(x, y, z, w);
 
-	return Vec4f( x/f, y/f, z/f, w/f );
+	return fromSimd( Simd::div(simd(), Simd::set1(f)) );
 }
 
 inline Vec4f& Vec4f::operator/=( const float f ) {
 	if(f == 0)return *this;
 
-	x /= f;
-	y /= f;
-	z /= f;
-	w /= f;
+	Simd::store(data, Simd::div(simd(), Simd::set1(f)));
 	return *this;
 }
 
@@ -487,10 +470,9 @@ inline Vec4f& Vec4f::operator/=( const float f ) {
 // }
 
 inline Vec4f Vec4f::getScaled( const float length ) const {
-	float l = (float)sqrt(x*x + y*y + z*z + w*w);
-	if( l > 0 )
-		return Vec4f( (x/l)*length, (y/l)*length,
-					   (z/l)*length, (w/l)*length );
+	const VecPrecision::Length l(lengthSquared());
+	if( l.positive() )
+		return fromSimd( Simd::mul(l.divide(simd()), Simd::set1(length)) );
 	else
 		return Vec4f();
 }
@@ -500,12 +482,9 @@ inline Vec4f Vec4f::getScaled( const float length ) const {
 // }
 
 inline Vec4f& Vec4f::scale( const float length ) {
-	float l = (float)sqrt(x*x + y*y + z*z + w*w);
-	if (l > 0) {
-		x = (x/l)*length;
-		y = (y/l)*length;
-		z = (z/l)*length;
-		w = (w/l)*length;
+	const VecPrecision::Length l(lengthSquared());
+	if( l.positive() ) {
+		Simd::store(data, Simd::mul(l.divide(simd()), Simd::set1(length)));
 	}
 	return *this;
 }
@@ -516,11 +495,7 @@ inline Vec4f& Vec4f::scale( const float length ) {
 //
 //
 inline float Vec4f::distance( const Vec4f& pnt) const {
-	float vx = x-pnt.x;
-	float vy = y-pnt.y;
-	float vz = z-pnt.z;
-	float vw = w-pnt.w;
-	return (float)sqrt( vx*vx + vy*vy + vz*vz + vw*vw );
+	return (float)sqrt( squareDistance(pnt) );
 }
 
 // inline float Vec4f::distanceSquared( const Vec4f& pnt ) const {
@@ -528,11 +503,8 @@ inline float Vec4f::distance( const Vec4f& pnt) const {
 // }
 
 inline float Vec4f::squareDistance( const Vec4f& pnt ) const {
-	float vx = x-pnt.x;
-	float vy = y-pnt.y;
-	float vz = z-pnt.z;
-	float vw = w-pnt.w;
-	return vx*vx + vy*vy + vz*vz + vw*vw;
+	const Simd::f32x4 v = Simd::sub(simd(), pnt.simd());
+	return Simd::hsum(Simd::mul(v, v));
 }
 
 
@@ -549,17 +521,11 @@ inline float Vec4f::squareDistance( const Vec4f& pnt ) const {
 // }
 
 inline Vec4f Vec4f::getInterpolated( const Vec4f& pnt, float p ) const {
-	return Vec4f( x*(1-p) + pnt.x*p,
-				   y*(1-p) + pnt.y*p,
-				   z*(1-p) + pnt.z*p,
-				   w*(1-p) + pnt.w*p );
+	return fromSimd( Simd::add(Simd::mul(simd(), Simd::set1(1-p)), Simd::mul(pnt.simd(), Simd::set1(p))) );
 }
 
 inline Vec4f& Vec4f::interpolate( const Vec4f& pnt, float p ) {
-	x = x*(1-p) + pnt.x*p;
-	y = y*(1-p) + pnt.y*p;
-	z = z*(1-p) + pnt.z*p;
-	w = w*(1-p) + pnt.w*p;
+	Simd::store(data, Simd::add(Simd::mul(simd(), Simd::set1(1-p)), Simd::mul(pnt.simd(), Simd::set1(p))));
 	return *this;
 }
 
@@ -568,15 +534,11 @@ inline Vec4f& Vec4f::interpolate( const Vec4f& pnt, float p ) {
 // }
 
 inline Vec4f Vec4f::getMiddle( const Vec4f& pnt ) const {
-	return Vec4f( (x+pnt.x)/2.0f, (y+pnt.y)/2.0f,
-				   (z+pnt.z)/2.0f, (w+pnt.w)/2.0f );
+	return fromSimd( Simd::div(Simd::add(simd(), pnt.simd()), Simd::set1(2.0f)) );
 }
 
 inline Vec4f& Vec4f::middle( const Vec4f& pnt ) {
-	x = (x+pnt.x)/2.0f;
-	y = (y+pnt.y)/2.0f;
-	z = (z+pnt.z)/2.0f;
-	w = (w+pnt.w)/2.0f;
+	Simd::store(data, Simd::div(Simd::add(simd(), pnt.simd()), Simd::set1(2.0f)));
 	return *this;
 }
 
@@ -586,20 +548,11 @@ inline Vec4f& Vec4f::middle( const Vec4f& pnt ) {
 //
 //
 inline Vec4f& Vec4f::average( const Vec4f* points, int num ) {
-	x = 0.f;
-	y = 0.f;
-	z = 0.f;
-	w = 0.f;
+	Simd::f32x4 sum = Simd::set1(0.f);
 	for( int i=0; i<num; i++) {
-		x += points[i].x;
-		y += points[i].y;
-		z += points[i].z;
-		w += points[i].w;
+		sum = Simd::add(sum, points[i].simd());
 	}
-	x /= num;
-	y /= num;
-	z /= num;
-	w /= num;
+	Simd::store(data, Simd::div(sum, Simd::set1((float)num)));
 	return *this;
 }
 
@@ -613,21 +566,18 @@ inline Vec4f& Vec4f::average( const Vec4f* points, int num ) {
 // }
 
 inline Vec4f Vec4f::getNormalized() const {
-	float length = sqrt(x*x + y*y + z*z + w*w);
-	if( length > 0 ) {
-		return Vec4f( x/length, y/length, z/length, w/length );
+	const VecPrecision::Length length(lengthSquared());
+	if( length.positive() ) {
+		return fromSimd( length.divide(simd()) );
 	} else {
 		return Vec4f();
 	}
 }
 
 inline Vec4f& Vec4f::normalize() {
-	float length = sqrt(x*x + y*y + z*z + w*w);
-	if( length > 0 ) {
-		x /= length;
-		y /= length;
-		z /= length;
-		w /= length;
+	const VecPrecision::Length length(lengthSquared());
+	if( length.positive() ) {
+		Simd::store(data, length.divide(simd()));
 	}
 	return *this;
 }
@@ -642,25 +592,19 @@ inline Vec4f& Vec4f::normalize() {
 // }
 
 inline Vec4f Vec4f::getLimited(float max) const {
-    Vec4f limited;
-    float lengthSquared = (x*x + y*y + z*z + w*w);
+    float lengthSquared = this->lengthSquared();
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
-        limited.set( x*ratio, y*ratio, z*ratio, w*ratio );
-    } else {
-        limited.set(x,y,z,w);
+        float ratio = max/VecPrecision::Length(lengthSquared);
+        return fromSimd( Simd::mul(simd(), Simd::set1(ratio)) );
     }
-    return limited;
+    return *this;
 }
 
 inline Vec4f& Vec4f::limit(float max) {
-    float lengthSquared = (x*x + y*y + z*z + w*w);
+    float lengthSquared = this->lengthSquared();
     if( lengthSquared > max*max && lengthSquared > 0 ) {
-        float ratio = max/sqrt(lengthSquared);
-        x *= ratio;
-        y *= ratio;
-        z *= ratio;
-        w *= ratio;
+        float ratio = max/VecPrecision::Length(lengthSquared);
+        Simd::store(data, Simd::mul(simd(), Simd::set1(ratio)));
     }
     return *this;
 }
@@ -675,7 +619,8 @@ inline float Vec4f::length() const {
 }
 
 inline float Vec4f::lengthSquared() const {
-	return (x*x + y*y + z*z + w*w);
+	const Simd::f32x4 v = simd();
+	return Simd::hsum(Simd::mul(v, v));
 }
 
 
@@ -685,7 +630,7 @@ inline float Vec4f::lengthSquared() const {
  * Dot Product.
  */
 inline float Vec4f::dot( const Vec4f& vec ) const {
-	return x*vec.x + y*vec.y + z*vec.z + w*vec.w;
+	return Simd::hsum(Simd::mul(simd(), vec.simd()));
 }
 
 
@@ -696,19 +641,19 @@ inline float Vec4f::dot( const Vec4f& vec ) const {
 //
 //
 inline Vec4f operator+( float f, const Vec4f& vec ) {
-    return Vec4f( f+vec.x, f+vec.y, f+vec.z, f+vec.w );
+    return Vec4f::fromSimd( Simd::add(Simd::set1(f), vec.simd()) );
 }
 
 inline Vec4f operator-( float f, const Vec4f& vec ) {
-    return Vec4f( f-vec.x, f-vec.y, f-vec.z, f-vec.w );
+    return Vec4f::fromSimd( Simd::sub(Simd::set1(f), vec.simd()) );
 }
 
 inline Vec4f operator*( float f, const Vec4f& vec ) {
-    return Vec4f( f*vec.x, f*vec.y, f*vec.z, f*vec.w );
+    return Vec4f::fromSimd( Simd::mul(Simd::set1(f), vec.simd()) );
 }
 
 inline Vec4f operator/( float f, const Vec4f& vec ) {
-    return Vec4f( f/vec.x, f/vec.y, f/vec.z, f/vec.w);
+    return Vec4f::fromSimd( Simd::div(Simd::set1(f), vec.simd()) );
 }
 
 
@@ -0,0 +1,618 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_VECARRAY_H
+#define EMBEDDEDUTILS_VECARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Simd.h"
+#include "Vec2f.h"
+#include "Vec3f.h"
+#include "Vec3fA.h"
+#include "VecPrecision.h"
+
+// structure-of-arrays storage and batch kernels for large vector sets (point clouds, particles)
+// - Vec3fArray / Vec2fArray keep one 32 byte aligned float stream per component, so the
+//   kernels in VecBatch process Simd::Wide::WIDTH vectors per instruction (8 with AVX, 4 with SSE / NEON)
+// - Vec3fSpan / Vec2fSpan are non-owning views; fromAoS() wraps an existing Vec3f / Vec3fA / Vec2f
+//   buffer in place (strided), so the same kernels run on AoS data without copying, one vector at a time
+// - every kernel uses the same formula as the matching Vec3f / Vec2f method, so the results are
+//   bit-identical as long as the compiler does not contract the scalar code into FMAs; normalize()
+//   follows EMBEDDEDUTILS_VEC_PRECISION like getNormalized() (see VecPrecision.h)
+
+static_assert(sizeof(Vec3f) == 3 * sizeof(float), "Vec3f must be three packed floats");
+static_assert(sizeof(Vec2f) == 2 * sizeof(float), "Vec2f must be two packed floats");
+
+/// \brief Non-owning view of `size` 3D vectors stored as three float streams.
+///
+/// Vector `i` is `(x[i*stride], y[i*stride], z[i*stride])`. Views of a Vec3fArray have
+/// stride 1; fromAoS() views a Vec3f (stride 3) or Vec3fA (stride 4) buffer in place.
+///
+/// ~~~~{.cpp}
+/// Vec3f points[100];
+/// VecBatch::normalize(Vec3fSpan::fromAoS(points, 100)); // normalizes points[] in place
+/// ~~~~
+template<typename F>
+struct BasicVec3fSpan {
+	typedef typename std::conditional<std::is_const<F>::value, const Vec3f, Vec3f>::type vec_type;
+	typedef typename std::conditional<std::is_const<F>::value, const Vec3fA, Vec3fA>::type veca_type;
+
+	F* x;
+	F* y;
+	F* z;
+	size_t size;
+	size_t stride;
+
+	BasicVec3fSpan() : x(nullptr), y(nullptr), z(nullptr), size(0), stride(1) {}
+	BasicVec3fSpan( F* x, F* y, F* z, size_t size, size_t stride = 1 ) : x(x), y(y), z(z), size(size), stride(stride) {}
+
+	/// \brief A mutable view converts to a read-only one.
+	template<typename G, typename = typename std::enable_if<std::is_same<G, typename std::remove_const<F>::type>::value>::type>
+	BasicVec3fSpan( const BasicVec3fSpan<G>& s ) : x(s.x), y(s.y), z(s.z), size(s.size), stride(s.stride) {}
+
+	/// \brief View `n` Vec3f in place.
+	static BasicVec3fSpan fromAoS( vec_type* p, size_t n ) {
+		if( p == nullptr ) return BasicVec3fSpan();
+		return BasicVec3fSpan( p->data, p->data + 1, p->data + 2, n, 3 );
+	}
+
+	/// \brief View `n` Vec3fA in place.
+	static BasicVec3fSpan fromAoS( veca_type* p, size_t n ) {
+		if( p == nullptr ) return BasicVec3fSpan();
+		return BasicVec3fSpan( p->data, p->data + 1, p->data + 2, n, 4 );
+	}
+
+	bool contiguous() const { return stride == 1; }
+
+	Vec3f get( size_t i ) const {
+		const size_t k = i * stride;
+		return Vec3f( x[k], y[k], z[k] );
+	}
+	void set( size_t i, const Vec3f& v ) const {
+		const size_t k = i * stride;
+		x[k] = v.x;
+		y[k] = v.y;
+		z[k] = v.z;
+	}
+
+	/// \brief The `count` vectors from `offset`.
+	BasicVec3fSpan subspan( size_t offset, size_t count ) const {
+		const size_t k = offset * stride;
+		return BasicVec3fSpan( x + k, y + k, z + k, count, stride );
+	}
+};
+
+typedef BasicVec3fSpan<float> Vec3fSpan;
+typedef BasicVec3fSpan<const float> ConstVec3fSpan;
+
+/// \brief Non-owning view of `size` 2D vectors stored as two float streams.
+///
+/// Vector `i` is `(x[i*stride], y[i*stride])`. Views of a Vec2fArray have stride 1;
+/// fromAoS() views a Vec2f buffer in place (stride 2).
+template<typename F>
+struct BasicVec2fSpan {
+	typedef typename std::conditional<std::is_const<F>::value, const Vec2f, Vec2f>::type vec_type;
+
+	F* x;
+	F* y;
+	size_t size;
+	size_t stride;
+
+	BasicVec2fSpan() : x(nullptr), y(nullptr), size(0), stride(1) {}
+	BasicVec2fSpan( F* x, F* y, size_t size, size_t stride = 1 ) : x(x), y(y), size(size), stride(stride) {}
+
+	/// \brief A mutable view converts to a read-only one.
+	template<typename G, typename = typename std::enable_if<std::is_same<G, typename std::remove_const<F>::type>::value>::type>
+	BasicVec2fSpan( const BasicVec2fSpan<G>& s ) : x(s.x), y(s.y), size(s.size), stride(s.stride) {}
+
+	/// \brief View `n` Vec2f in place.
+	static BasicVec2fSpan fromAoS( vec_type* p, size_t n ) {
+		if( p == nullptr ) return BasicVec2fSpan();
+		return BasicVec2fSpan( p->data, p->data + 1, n, 2 );
+	}
+
+	bool contiguous() const { return stride == 1; }
+
+	Vec2f get( size_t i ) const {
+		const size_t k = i * stride;
+		return Vec2f( x[k], y[k] );
+	}
+	void set( size_t i, const Vec2f& v ) const {
+		const size_t k = i * stride;
+		x[k] = v.x;
+		y[k] = v.y;
+	}
+
+	/// \brief The `count` vectors from `offset`.
+	BasicVec2fSpan subspan( size_t offset, size_t count ) const {
+		const size_t k = offset * stride;
+		return BasicVec2fSpan( x + k, y + k, count, stride );
+	}
+};
+
+typedef BasicVec2fSpan<float> Vec2fSpan;
+typedef BasicVec2fSpan<const float> ConstVec2fSpan;
+
+/// \cond INTERNAL
+// DIM float streams of capacity() floats each, in one allocation; every stream starts on a 32 byte boundary
+template<size_t DIM>
+class VecStreams {
+public:
+	VecStreams() : base_(nullptr), size_(0), capacity_(0) {}
+	VecStreams( const VecStreams& other ) : VecStreams() {
+		reserve(other.size_);
+		copy_from(other);
+	}
+	VecStreams( VecStreams&& other ) noexcept : VecStreams() { swap(other); }
+
+	VecStreams& operator=( const VecStreams& other ) {
+		if( this != &other ) {
+			reserve(other.size_);
+			copy_from(other);
+		}
+		return *this;
+	}
+	VecStreams& operator=( VecStreams&& other ) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	size_t size() const { return size_; }
+	size_t capacity() const { return capacity_; }
+
+	float* stream( size_t k ) { return base_ + k * capacity_; }
+	const float* stream( size_t k ) const { return base_ + k * capacity_; }
+
+	void reserve( size_t n ) {
+		if( n <= capacity_ ) return;
+		if( n < 2 * capacity_ ) n = 2 * capacity_;
+		const size_t capacity = (n + LANES - 1) & ~(LANES - 1);
+		std::unique_ptr<float[]> storage( new float[DIM * capacity + LANES - 1] );
+		float* base = align(storage.get());
+		for( size_t k = 0; k < DIM; ++k ) {
+			if( size_ ) std::memcpy(base + k * capacity, stream(k), size_ * sizeof(float));
+		}
+		storage_ = std::move(storage);
+		base_ = base;
+		capacity_ = capacity;
+	}
+
+	// new vectors are zero
+	void resize( size_t n ) {
+		reserve(n);
+		if( n > size_ ) {
+			for( size_t k = 0; k < DIM; ++k ) std::memset(stream(k) + size_, 0, (n - size_) * sizeof(float));
+		}
+		size_ = n;
+	}
+
+	void swap( VecStreams& other ) {
+		storage_.swap(other.storage_);
+		std::swap(base_, other.base_);
+		std::swap(size_, other.size_);
+		std::swap(capacity_, other.capacity_);
+	}
+
+private:
+	static constexpr size_t LANES = 32 / sizeof(float);
+
+	static float* align( float* p ) {
+		return reinterpret_cast<float*>((reinterpret_cast<uintptr_t>(p) + 31) & ~(uintptr_t)31);
+	}
+
+	void copy_from( const VecStreams& other ) {
+		for( size_t k = 0; k < DIM; ++k ) {
+			if( other.size_ ) std::memcpy(stream(k), other.stream(k), other.size_ * sizeof(float));
+		}
+		size_ = other.size_;
+	}
+
+	std::unique_ptr<float[]> storage_;
+	float* base_;
+	size_t size_;
+	size_t capacity_;
+};
+/// \endcond
+
+/// \brief Vec3fArray stores 3D vectors as separate, aligned x, y and z streams.
+///
+/// Elements are read and written by value (there is no Vec3f in memory to refer to);
+/// the bulk work goes through the VecBatch kernels.
+///
+/// ~~~~{.cpp}
+/// Vec3fArray cloud(points, n);   // copy from a Vec3f buffer
+/// std::vector<float> d(n);
+/// VecBatch::distance(cloud, Vec3f(0, 0, 1), d.data());
+/// VecBatch::normalize(cloud);
+/// cloud.copyTo(points);          // back to Vec3f
+/// ~~~~
+/// \sa Vec3fSpan, VecBatch
+class Vec3fArray {
+public:
+	Vec3fArray() {}
+
+	/// \brief `n` zero vectors.
+	explicit Vec3fArray( size_t n ) { streams_.resize(n); }
+
+	/// \brief Copy of `n` Vec3f.
+	Vec3fArray( const Vec3f* src, size_t n ) { assign(src, n); }
+
+	size_t size() const { return streams_.size(); }
+	size_t capacity() const { return streams_.capacity(); }
+	bool empty() const { return size() == 0; }
+
+	void reserve( size_t n ) { streams_.reserve(n); }
+	/// \brief Grows with zero vectors or shrinks to `n` vectors.
+	void resize( size_t n ) { streams_.resize(n); }
+	void clear() { streams_.resize(0); }
+
+	void push_back( const Vec3f& v ) {
+		const size_t i = size();
+		streams_.resize(i + 1);
+		set(i, v);
+	}
+
+	Vec3f operator[]( size_t i ) const { return get(i); }
+	Vec3f get( size_t i ) const { return Vec3f( x()[i], y()[i], z()[i] ); }
+	void set( size_t i, const Vec3f& v ) {
+		x()[i] = v.x;
+		y()[i] = v.y;
+		z()[i] = v.z;
+	}
+
+	float* x() { return streams_.stream(0); }
+	float* y() { return streams_.stream(1); }
+	float* z() { return streams_.stream(2); }
+	const float* x() const { return streams_.stream(0); }
+	const float* y() const { return streams_.stream(1); }
+	const float* z() const { return streams_.stream(2); }
+
+	Vec3fSpan span() { return Vec3fSpan( x(), y(), z(), size() ); }
+	ConstVec3fSpan span() const { return ConstVec3fSpan( x(), y(), z(), size() ); }
+	operator Vec3fSpan() { return span(); }
+	operator ConstVec3fSpan() const { return span(); }
+
+	/// \brief Replace the contents with a copy of `n` vectors from a Vec3f buffer.
+	void assign( const Vec3f* src, size_t n ) {
+		streams_.resize(n);
+		for( size_t i = 0; i < n; ++i ) set(i, src[i]);
+	}
+
+	/// \brief Copy the contents to a Vec3f buffer of at least size() vectors.
+	void copyTo( Vec3f* dst ) const {
+		for( size_t i = 0; i < size(); ++i ) dst[i] = get(i);
+	}
+
+private:
+	VecStreams<3> streams_;
+};
+
+/// \brief Vec2fArray stores 2D vectors as separate, aligned x and y streams.
+/// \sa Vec3fArray, Vec2fSpan, VecBatch
+class Vec2fArray {
+public:
+	Vec2fArray() {}
+
+	/// \brief `n` zero vectors.
+	explicit Vec2fArray( size_t n ) { streams_.resize(n); }
+
+	/// \brief Copy of `n` Vec2f.
+	Vec2fArray( const Vec2f* src, size_t n ) { assign(src, n); }
+
+	size_t size() const { return streams_.size(); }
+	size_t capacity() const { return streams_.capacity(); }
+	bool empty() const { return size() == 0; }
+
+	void reserve( size_t n ) { streams_.reserve(n); }
+	/// \brief Grows with zero vectors or shrinks to `n` vectors.
+	void resize( size_t n ) { streams_.resize(n); }
+	void clear() { streams_.resize(0); }
+
+	void push_back( const Vec2f& v ) {
+		const size_t i = size();
+		streams_.resize(i + 1);
+		set(i, v);
+	}
+
+	Vec2f operator[]( size_t i ) const { return get(i); }
+	Vec2f get( size_t i ) const { return Vec2f( x()[i], y()[i] ); }
+	void set( size_t i, const Vec2f& v ) {
+		x()[i] = v.x;
+		y()[i] = v.y;
+	}
+
+	float* x() { return streams_.stream(0); }
+	float* y() { return streams_.stream(1); }
+	const float* x() const { return streams_.stream(0); }
+	const float* y() const { return streams_.stream(1); }
+
+	Vec2fSpan span() { return Vec2fSpan( x(), y(), size() ); }
+	ConstVec2fSpan span() const { return ConstVec2fSpan( x(), y(), size() ); }
+	operator Vec2fSpan() { return span(); }
+	operator ConstVec2fSpan() const { return span(); }
+
+	/// \brief Replace the contents with a copy of `n` vectors from a Vec2f buffer.
+	void assign( const Vec2f* src, size_t n ) {
+		streams_.resize(n);
+		for( size_t i = 0; i < n; ++i ) set(i, src[i]);
+	}
+
+	/// \brief Copy the contents to a Vec2f buffer of at least size() vectors.
+	void copyTo( Vec2f* dst ) const {
+		for( size_t i = 0; i < size(); ++i ) dst[i] = get(i);
+	}
+
+private:
+	VecStreams<2> streams_;
+};
+
+/// \brief Batch kernels over Vec3fSpan / Vec2fSpan (and so over Vec3fArray, Vec2fArray and fromAoS() views).
+///
+/// The first input sets the count; the other inputs and the output must hold at least as many
+/// vectors. The output may be one of the inputs. When every view is contiguous the kernels run
+/// Simd::Wide::WIDTH vectors at a time, strided (AoS) views fall back to one vector at a time.
+/// Scalar results (dot, length, distance) go to a plain float array.
+namespace VecBatch {
+
+	/// \cond INTERNAL
+	namespace W = Simd::Wide;
+
+	template<typename A, typename B, typename C>
+	inline bool contiguous( const A& a, const B& b, const C& c ) {
+		return a.contiguous() && b.contiguous() && c.contiguous();
+	}
+	/// \endcond
+
+	//---------------------
+	/// \name 3D
+	/// \{
+
+	/// \brief out[i] = a[i] + b[i]
+	inline void add( const ConstVec3fSpan& a, const ConstVec3fSpan& b, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::add(W::load(a.x + i), W::load(b.x + i)));
+				W::store(out.y + i, W::add(W::load(a.y + i), W::load(b.y + i)));
+				W::store(out.z + i, W::add(W::load(a.z + i), W::load(b.z + i)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) + b.get(i));
+	}
+
+	/// \brief out[i] = a[i] - b[i]
+	inline void sub( const ConstVec3fSpan& a, const ConstVec3fSpan& b, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::sub(W::load(a.x + i), W::load(b.x + i)));
+				W::store(out.y + i, W::sub(W::load(a.y + i), W::load(b.y + i)));
+				W::store(out.z + i, W::sub(W::load(a.z + i), W::load(b.z + i)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) - b.get(i));
+	}
+
+	/// \brief out[i] = a[i] * f
+	inline void scale( const ConstVec3fSpan& a, float f, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, a, out) ) {
+			const W::f32xN s = W::set1(f);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::mul(W::load(a.x + i), s));
+				W::store(out.y + i, W::mul(W::load(a.y + i), s));
+				W::store(out.z + i, W::mul(W::load(a.z + i), s));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) * f);
+	}
+
+	/// \brief out[i] = a[i].dot(b[i])
+	inline void dot( const ConstVec3fSpan& a, const ConstVec3fSpan& b, float* out ) {
+		size_t i = 0;
+		if( contiguous(a, b, a) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN xx = W::mul(W::load(a.x + i), W::load(b.x + i));
+				const W::f32xN yy = W::mul(W::load(a.y + i), W::load(b.y + i));
+				const W::f32xN zz = W::mul(W::load(a.z + i), W::load(b.z + i));
+				W::store(out + i, W::add(W::add(xx, yy), zz));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).dot(b.get(i));
+	}
+
+	/// \brief out[i] = a[i].getCrossed(b[i])
+	inline void cross( const ConstVec3fSpan& a, const ConstVec3fSpan& b, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN ax = W::load(a.x + i), ay = W::load(a.y + i), az = W::load(a.z + i);
+				const W::f32xN bx = W::load(b.x + i), by = W::load(b.y + i), bz = W::load(b.z + i);
+				W::store(out.x + i, W::sub(W::mul(ay, bz), W::mul(az, by)));
+				W::store(out.y + i, W::sub(W::mul(az, bx), W::mul(ax, bz)));
+				W::store(out.z + i, W::sub(W::mul(ax, by), W::mul(ay, bx)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i).getCrossed(b.get(i)));
+	}
+
+	/// \brief out[i] = a[i].length()
+	inline void length( const ConstVec3fSpan& a, float* out ) {
+		size_t i = 0;
+		if( a.contiguous() ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::load(a.x + i), y = W::load(a.y + i), z = W::load(a.z + i);
+				W::store(out + i, W::sqrt(W::add(W::add(W::mul(x, x), W::mul(y, y)), W::mul(z, z))));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).length();
+	}
+
+	/// \brief out[i] = a[i].getNormalized(); zero vectors stay zero
+	inline void normalize( const ConstVec3fSpan& a, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, a, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::load(a.x + i), y = W::load(a.y + i), z = W::load(a.z + i);
+				const VecPrecision::WideLength l(W::add(W::add(W::mul(x, x), W::mul(y, y)), W::mul(z, z)));
+				W::store(out.x + i, l.divide(x));
+				W::store(out.y + i, l.divide(y));
+				W::store(out.z + i, l.divide(z));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i).getNormalized());
+	}
+
+	/// \brief Normalize every vector of `a` in place.
+	inline void normalize( const Vec3fSpan& a ) { normalize(a, a); }
+
+	/// \brief out[i] = a[i].distance(pnt)
+	inline void distance( const ConstVec3fSpan& a, const Vec3f& pnt, float* out ) {
+		size_t i = 0;
+		if( a.contiguous() ) {
+			const W::f32xN px = W::set1(pnt.x), py = W::set1(pnt.y), pz = W::set1(pnt.z);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::sub(W::load(a.x + i), px);
+				const W::f32xN y = W::sub(W::load(a.y + i), py);
+				const W::f32xN z = W::sub(W::load(a.z + i), pz);
+				W::store(out + i, W::sqrt(W::add(W::add(W::mul(x, x), W::mul(y, y)), W::mul(z, z))));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).distance(pnt);
+	}
+
+	/// \brief out[i] = a[i].getInterpolated(b[i], p)
+	inline void lerp( const ConstVec3fSpan& a, const ConstVec3fSpan& b, float p, const Vec3fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			const W::f32xN q = W::set1(1 - p), s = W::set1(p);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::add(W::mul(W::load(a.x + i), q), W::mul(W::load(b.x + i), s)));
+				W::store(out.y + i, W::add(W::mul(W::load(a.y + i), q), W::mul(W::load(b.y + i), s)));
+				W::store(out.z + i, W::add(W::mul(W::load(a.z + i), q), W::mul(W::load(b.z + i), s)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i).getInterpolated(b.get(i), p));
+	}
+
+	/// \}
+
+	//---------------------
+	/// \name 2D
+	/// \{
+
+	/// \brief out[i] = a[i] + b[i]
+	inline void add( const ConstVec2fSpan& a, const ConstVec2fSpan& b, const Vec2fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::add(W::load(a.x + i), W::load(b.x + i)));
+				W::store(out.y + i, W::add(W::load(a.y + i), W::load(b.y + i)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) + b.get(i));
+	}
+
+	/// \brief out[i] = a[i] - b[i]
+	inline void sub( const ConstVec2fSpan& a, const ConstVec2fSpan& b, const Vec2fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::sub(W::load(a.x + i), W::load(b.x + i)));
+				W::store(out.y + i, W::sub(W::load(a.y + i), W::load(b.y + i)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) - b.get(i));
+	}
+
+	/// \brief out[i] = a[i] * f
+	inline void scale( const ConstVec2fSpan& a, float f, const Vec2fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, a, out) ) {
+			const W::f32xN s = W::set1(f);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::mul(W::load(a.x + i), s));
+				W::store(out.y + i, W::mul(W::load(a.y + i), s));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i) * f);
+	}
+
+	/// \brief out[i] = a[i].dot(b[i])
+	inline void dot( const ConstVec2fSpan& a, const ConstVec2fSpan& b, float* out ) {
+		size_t i = 0;
+		if( contiguous(a, b, a) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN xx = W::mul(W::load(a.x + i), W::load(b.x + i));
+				const W::f32xN yy = W::mul(W::load(a.y + i), W::load(b.y + i));
+				W::store(out + i, W::add(xx, yy));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).dot(b.get(i));
+	}
+
+	/// \brief out[i] = a[i].length()
+	inline void length( const ConstVec2fSpan& a, float* out ) {
+		size_t i = 0;
+		if( a.contiguous() ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::load(a.x + i), y = W::load(a.y + i);
+				W::store(out + i, W::sqrt(W::add(W::mul(x, x), W::mul(y, y))));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).length();
+	}
+
+	/// \brief out[i] = a[i].getNormalized(); zero vectors stay zero
+	inline void normalize( const ConstVec2fSpan& a, const Vec2fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, a, out) ) {
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::load(a.x + i), y = W::load(a.y + i);
+				const VecPrecision::WideLength l(W::add(W::mul(x, x), W::mul(y, y)));
+				W::store(out.x + i, l.divide(x));
+				W::store(out.y + i, l.divide(y));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i).getNormalized());
+	}
+
+	/// \brief Normalize every vector of `a` in place.
+	inline void normalize( const Vec2fSpan& a ) { normalize(a, a); }
+
+	/// \brief out[i] = a[i].distance(pnt)
+	inline void distance( const ConstVec2fSpan& a, const Vec2f& pnt, float* out ) {
+		size_t i = 0;
+		if( a.contiguous() ) {
+			const W::f32xN px = W::set1(pnt.x), py = W::set1(pnt.y);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				const W::f32xN x = W::sub(W::load(a.x + i), px);
+				const W::f32xN y = W::sub(W::load(a.y + i), py);
+				W::store(out + i, W::sqrt(W::add(W::mul(x, x), W::mul(y, y))));
+			}
+		}
+		for( ; i < a.size; ++i ) out[i] = a.get(i).distance(pnt);
+	}
+
+	/// \brief out[i] = a[i].getInterpolated(b[i], p)
+	inline void lerp( const ConstVec2fSpan& a, const ConstVec2fSpan& b, float p, const Vec2fSpan& out ) {
+		size_t i = 0;
+		if( contiguous(a, b, out) ) {
+			const W::f32xN q = W::set1(1 - p), s = W::set1(p);
+			for( ; i + W::WIDTH <= a.size; i += W::WIDTH ) {
+				W::store(out.x + i, W::add(W::mul(W::load(a.x + i), q), W::mul(W::load(b.x + i), s)));
+				W::store(out.y + i, W::add(W::mul(W::load(a.y + i), q), W::mul(W::load(b.y + i), s)));
+			}
+		}
+		for( ; i < a.size; ++i ) out.set(i, a.get(i).getInterpolated(b.get(i), p));
+	}
+
+	/// \}
+}
+
+#endif // EMBEDDEDUTILS_VECARRAY_H
@@ -0,0 +1,156 @@
+#pragma once
+
+#ifndef EMBEDDEDUTILS_VECPRECISION_H
+#define EMBEDDEDUTILS_VECPRECISION_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Simd.h"
+
+// precision policy of the normalizing Vec2f / Vec3f / Vec3fA / Vec4f methods
+// (normalize, getNormalized, scale, getScaled, limit, getLimited, perpendicular, getPerpendicular)
+// and of VecBatch::normalize, which gives the same results as getNormalized under either policy
+// - EMBEDDEDUTILS_VEC_PRECISION_EXACT (default): sqrt, then one divide per component
+// - EMBEDDEDUTILS_VEC_PRECISION_FAST: one approximate reciprocal square root, then one multiply
+//   per component; maximum relative error of 1/|v|, and so of every component of the result:
+//     SSE (x86)        rsqrtss + 1 Newton-Raphson step                      2.8e-7
+//     NEON (Cortex-A)  vrsqrte + 2 Newton-Raphson steps                     < 1e-6
+//     anything else    bit-trick seed + 2 Newton-Raphson steps              4.8e-6
+//                      (Cortex-M4F / M7 have no estimate instruction, AVR no FPU)
+//   limit() / getLimited() keep the exact test against max and only approximate the ratio
+//   length(), distance() and every other method stay exact
+//   it pays off where divide and square root are slow (Cortex-M4F: 14 cycles each, not pipelined);
+//   on desktop x86 with pipelined divsqrt units it gains little; examples/VecPrecision measures
+//   the time of both and the error of rsqrt() on the target
+// - define EMBEDDEDUTILS_VEC_PRECISION the same way in every translation unit (e.g. in the build flags)
+#define EMBEDDEDUTILS_VEC_PRECISION_EXACT 0
+#define EMBEDDEDUTILS_VEC_PRECISION_FAST  1
+
+#ifndef EMBEDDEDUTILS_VEC_PRECISION
+#define EMBEDDEDUTILS_VEC_PRECISION EMBEDDEDUTILS_VEC_PRECISION_EXACT
+#endif
+
+namespace VecPrecision
+{
+    // approximate 1 / sqrt(f) for normal, finite f > 0
+    inline float rsqrt(const float f)
+    {
+#if defined(EMBEDDEDUTILS_SIMD_SSE)
+        const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(f)));
+        return y * (1.5f - 0.5f * f * y * y);
+#elif defined(EMBEDDEDUTILS_SIMD_NEON)
+        // vrsqrts(a, b) is (3 - a * b) / 2
+        const float32x2_t v = vdup_n_f32(f);
+        float32x2_t y = vrsqrte_f32(v);
+        y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+        y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+        return vget_lane_f32(y, 0);
+#else
+        uint32_t i;
+        memcpy(&i, &f, sizeof(i));
+        i = 0x5f375a86u - (i >> 1);
+        float y;
+        memcpy(&y, &i, sizeof(y));
+        const float h = 0.5f * f;
+        y = y * (1.5f - h * y * y);
+        return y * (1.5f - h * y * y);
+#endif
+    }
+
+    // |v| as the divisor of the normalizing methods, built from |v|^2:
+    // x / length is x / sqrt(|v|^2) with EXACT and x * rsqrt(|v|^2) with FAST
+    class Length
+    {
+    public:
+
+#if EMBEDDEDUTILS_VEC_PRECISION == EMBEDDEDUTILS_VEC_PRECISION_FAST
+        explicit Length(const float lengthSquared) : positive_(lengthSquared > 0)
+        {
+            // denormal and infinite |v|^2 are outside the estimate's range
+            if (lengthSquared >= 1.17549435e-38f && lengthSquared <= 3.40282347e+38f) inv_ = rsqrt(lengthSquared);
+            else inv_ = 1.0f / (float)sqrt(lengthSquared);
+        }
+
+        inline bool positive() const { return positive_; }
+        inline float divide(const float v) const { return v * inv_; }
+        inline Simd::f32x4 divide(const Simd::f32x4 v) const { return Simd::mul(v, Simd::set1(inv_)); }
+
+    private:
+        float inv_;
+        bool positive_;
+#else
+        explicit Length(const float lengthSquared) : length_((float)sqrt(lengthSquared)) {}
+
+        inline bool positive() const { return length_ > 0; }
+        inline float divide(const float v) const { return v / length_; }
+        inline Simd::f32x4 divide(const Simd::f32x4 v) const { return Simd::div(v, Simd::set1(length_)); }
+
+    private:
+        float length_;
+#endif
+    };
+
+    // Length of Simd::Wide::WIDTH vectors at once for the VecArray.h batch kernels:
+    // every lane of divide() is what Length::divide() gives for that vector, and +0
+    // where |v|^2 is not positive (which is what getNormalized() returns there)
+    class WideLength
+    {
+        typedef Simd::Wide::f32xN f32xN;
+
+    public:
+
+#if EMBEDDEDUTILS_VEC_PRECISION == EMBEDDEDUTILS_VEC_PRECISION_FAST
+        explicit WideLength(const f32xN lengthSquared) : lengthSquared_(lengthSquared), inv_(inverse(lengthSquared)) {}
+
+        inline f32xN divide(const f32xN v) const { return Simd::Wide::select_positive(lengthSquared_, Simd::Wide::mul(v, inv_)); }
+
+    private:
+        // rsqrt() of every lane; the x86 estimate instructions give the same lanes as rsqrtss,
+        // other targets (and blocks with a lane outside the estimate's range) go through Length
+        static inline f32xN inverse(const f32xN lengthSquared)
+        {
+#if defined(EMBEDDEDUTILS_SIMD_AVX)
+            const __m256 ok = _mm256_and_ps(_mm256_cmp_ps(lengthSquared, _mm256_set1_ps(1.17549435e-38f), _CMP_GE_OQ),
+                                            _mm256_cmp_ps(lengthSquared, _mm256_set1_ps(3.40282347e+38f), _CMP_LE_OQ));
+            if (_mm256_movemask_ps(ok) == 0xFF)
+            {
+                const __m256 y = _mm256_rsqrt_ps(lengthSquared);
+                const __m256 h = _mm256_mul_ps(_mm256_set1_ps(0.5f), lengthSquared);
+                return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(h, y), y)));
+            }
+#elif defined(EMBEDDEDUTILS_SIMD_SSE)
+            const __m128 ok = _mm_and_ps(_mm_cmpge_ps(lengthSquared, _mm_set1_ps(1.17549435e-38f)),
+                                         _mm_cmple_ps(lengthSquared, _mm_set1_ps(3.40282347e+38f)));
+            if (_mm_movemask_ps(ok) == 0x0F)
+            {
+                const __m128 y = _mm_rsqrt_ps(lengthSquared);
+                const __m128 h = _mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared);
+                return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(h, y), y)));
+            }
+#endif
+            float l[Simd::Wide::WIDTH];
+            Simd::Wide::store(l, lengthSquared);
+            for (int i = 0; i < Simd::Wide::WIDTH; ++i) l[i] = Length(l[i]).divide(1.0f);
+            return Simd::Wide::load(l);
+        }
+
+        f32xN lengthSquared_;
+        f32xN inv_;
+#else
+        explicit WideLength(const f32xN lengthSquared) : lengthSquared_(lengthSquared), length_(Simd::Wide::sqrt(lengthSquared)) {}
+
+        inline f32xN divide(const f32xN v) const { return Simd::Wide::select_positive(lengthSquared_, Simd::Wide::div(v, length_)); }
+
+    private:
+        f32xN lengthSquared_;
+        f32xN length_;
+#endif
+    };
+
+    inline float operator/ (const float v, const Length& length) { return length.divide(v); }
+    inline float& operator/= (float& v, const Length& length) { return v = length.divide(v); }
+}
+
+#endif // EMBEDDEDUTILS_VECPRECISION_H